@@ -0,0 +1,84 @@
+#ifndef DataFormats_PatCandidates_CacheState_h
+#define DataFormats_PatCandidates_CacheState_h
+
+/**
+  \class    pat::CacheState CacheState.h "DataFormats/PatCandidates/interface/CacheState.h"
+  \brief    Publication state of a transient cache filled lazily by const methods
+
+   Some const methods of the PAT objects fill a transient cache on first use. To keep this safe
+   when the same const object is read by several threads, each cache is guarded by a CacheState:
+   the value is computed into a local variable first, then the thread winning the Empty => Filling
+   transition copies it into the cache and publishes it (Ready) after a release barrier, while the
+   other threads wait until they see Ready, which is read with an acquire barrier.
+   Readers never take a lock; they only wait while the winning thread stores the computed value,
+   which is meant to be short (a swap or a copy of a small value, never the computation itself).
+   waitReady() spins for a few iterations, then yields the processor at each check, so that a
+   filling thread which was descheduled is not starved by the waiting ones.
+
+   Non-const methods may reset() the state, as they must not run concurrently with readers anyway.
+   Copies start Empty, since a cache can point into the storage of the object it was built from.
+
+   The implementation uses the gcc __sync builtins (full barriers), as C++11 atomics are not available.
+*/
+
+#include <sched.h>
+
+namespace pat {
+
+  class CacheState {
+    public:
+      CacheState() : state_(Empty) {}
+      CacheState(const CacheState &) : state_(Empty) {}
+      CacheState & operator=(const CacheState &) { state_ = Empty; return *this; }
+
+      /// true if the cache has been published (acquire)
+      bool isReady() const ;
+      /// try to become the thread filling an empty cache; true on success
+      bool tryStartFill() const ;
+      /// try to become the thread filling again a published cache; only to be called when the caller
+      /// saw the published cache out of date, and on success the caller must check again that it is
+      /// still out of date before writing it (another thread may have refilled it in between), and
+      /// publish() in any case
+      bool tryStartRefill() const ;
+      /// publish the cache filled after a successful tryStartFill or tryStartRefill (release)
+      void publish() const ;
+      /// wait until the thread filling the cache has published it; only for short fills
+      void waitReady() const ;
+      /// mark the cache as empty; only for non-const methods
+      void reset() { state_ = Empty; }
+
+    private:
+      enum { Empty = 0, Filling = 1, Ready = 2 };
+      mutable volatile int state_;
+  };
+
+}
+
+#if !defined(__GCCXML__)
+inline bool pat::CacheState::isReady() const {
+  int state = state_;
+  __sync_synchronize(); // the cache must not be read before the state
+  return state == Ready;
+}
+
+inline bool pat::CacheState::tryStartFill() const {
+  return __sync_bool_compare_and_swap(&state_, int(Empty), int(Filling));
+}
+
+inline bool pat::CacheState::tryStartRefill() const {
+  return __sync_bool_compare_and_swap(&state_, int(Ready), int(Filling));
+}
+
+inline void pat::CacheState::publish() const {
+  __sync_synchronize(); // the cache must be written before the state
+  state_ = Ready;
+}
+
+inline void pat::CacheState::waitReady() const {
+  for (unsigned int spins = 0; !isReady(); ++spins) {
+    if (spins >= 64) sched_yield();
+  }
+}
+#endif
+
+#endif
@@ -5,6 +5,8 @@
 #include "DataFormats/Math/interface/LorentzVector.h"
 #include "DataFormats/Candidate/interface/CandidateFwd.h"
 #include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
 
 namespace pat {
   class CandKinResolution  {
@@ -77,13 +79,16 @@ namespace pat {
 
         /// Returns the full covariance matrix
         const AlgebraicSymMatrix44 & covariance()  const { 
-            if (!hasMatrix_) { fillMatrix(); hasMatrix_ = true; }
+            if (!hasMatrix_.isReady()) cacheMatrix();
             return covmatrix_; 
         }
 
         /// The constraints associated with this parametrization
         const std::vector<Scalar> & constraints() const { return constraints_; }
 
+        /// Round the stored covariances to the precision of the policy; the matrix is rebuilt on the next access
+        void reduceFloatPrecision(const FloatPrecisionPolicy & policy) ;
+
         /// Resolution on eta, given the 4-momentum of the associated Candidate
 	double resolEta(const LorentzVector &p4) const ;
 
@@ -133,7 +138,7 @@ namespace pat {
         // transient
 
         /// Did we make the Matrix from the vector?
-        mutable bool       hasMatrix_;
+        CacheState         hasMatrix_;
     
         /// Transient copy of the full 4x4 covariance matrix
         mutable AlgebraicSymMatrix44 covmatrix_;
@@ -141,7 +146,10 @@ namespace pat {
         //methods
 
         /// Fill matrix from vector
-        void fillMatrix() const ; // const: the matrix is mutable
+        void fillMatrix(AlgebraicSymMatrix44 &matrix) const ;
+
+        /// Fill the transient matrix from the vector, if no other thread did it first
+        void cacheMatrix() const ; // const: the matrix is mutable
 
         /// Fill vectoor from matrix
         void fillVector() ;
@@ -47,6 +47,9 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual CompositeCandidate * clone() const { return new CompositeCandidate(*this); }
 
+      /// Memory report of the PATObject part; the daughters are held by the reco::CompositeCandidate base
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+
   };
 
 
@@ -0,0 +1,81 @@
+#ifndef DataFormats_PatCandidates_ConstituentArrays_h
+#define DataFormats_PatCandidates_ConstituentArrays_h
+
+/**
+  \class    pat::ConstituentArrays ConstituentArrays.h "DataFormats/PatCandidates/interface/ConstituentArrays.h"
+  \brief    Kinematics of the constituents of one or more jets, as a structure of flat arrays
+
+   The pt, eta, phi, mass, charge and pdgId of the constituents are stored in one array each, the
+   constituents of the jet j being in the range [offset(j), offset(j+1)) of all the arrays. This
+   is the layout expected by substructure algorithms (N-subjettiness, energy correlation functions,
+   grooming), which can then loop over plain arrays instead of dereferencing each constituent.
+
+   The arrays can be filled for a whole jet collection once per event and put in the event, or
+   refilled for each jet reusing the same allocated memory (see pat::Jet::fillPFConstituentArrays).
+*/
+
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include <vector>
+
+namespace pat {
+
+  class ConstituentArrays {
+    public:
+      ConstituentArrays() : offsets_(1, 0) {}
+
+      /// remove all the jets, keeping the allocated memory
+      void clear() {
+        pt_.clear(); eta_.clear(); phi_.clear(); mass_.clear(); charge_.clear(); pdgId_.clear();
+        offsets_.resize(1);
+      }
+      /// reserve memory for the given number of jets and constituents
+      void reserve(size_t nJets, size_t nConstituents) {
+        pt_.reserve(nConstituents); eta_.reserve(nConstituents); phi_.reserve(nConstituents); mass_.reserve(nConstituents);
+        charge_.reserve(nConstituents); pdgId_.reserve(nConstituents);
+        offsets_.reserve(nJets + 1);
+      }
+      /// add a constituent to the current jet
+      void addConstituent(const reco::Candidate & constituent) {
+        pt_.push_back(constituent.pt());
+        eta_.push_back(constituent.eta());
+        phi_.push_back(constituent.phi());
+        mass_.push_back(constituent.mass());
+        charge_.push_back(constituent.charge());
+        pdgId_.push_back(constituent.pdgId());
+      }
+      /// add a constituent to the current jet, from its kinematics
+      void addConstituent(float pt, float eta, float phi, float mass, int charge, int pdgId) {
+        pt_.push_back(pt); eta_.push_back(eta); phi_.push_back(phi); mass_.push_back(mass);
+        charge_.push_back(charge); pdgId_.push_back(pdgId);
+      }
+      /// close the current jet, so that the next constituents belong to a new one
+      void endJet() { offsets_.push_back(pt_.size()); }
+
+      /// number of jets
+      size_t nJets() const { return offsets_.size() - 1; }
+      /// total number of constituents
+      size_t size() const { return pt_.size(); }
+      /// index of the first constituent of jet j; offset(nJets()) is size()
+      unsigned int offset(size_t j) const { return offsets_[j]; }
+      /// number of constituents of jet j
+      unsigned int nConstituents(size_t j) const { return offsets_[j+1] - offsets_[j]; }
+
+      /// flat arrays over all the constituents; add offset(j) to get the ones of jet j
+      const float * pt()     const { return pt_.empty()     ? 0 : &pt_[0]; }
+      const float * eta()    const { return eta_.empty()    ? 0 : &eta_[0]; }
+      const float * phi()    const { return phi_.empty()    ? 0 : &phi_[0]; }
+      const float * mass()   const { return mass_.empty()   ? 0 : &mass_[0]; }
+      const int   * charge() const { return charge_.empty() ? 0 : &charge_[0]; }
+      const int   * pdgId()  const { return pdgId_.empty()  ? 0 : &pdgId_[0]; }
+      /// the offsets, nJets()+1 entries
+      const std::vector<unsigned int> & offsets() const { return offsets_; }
+
+    private:
+      std::vector<float> pt_, eta_, phi_, mass_;
+      std::vector<int>   charge_, pdgId_;
+      std::vector<unsigned int> offsets_;
+  };
+
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef DataFormats_PatCandidates_ConstituentView_h
+#define DataFormats_PatCandidates_ConstituentView_h
+
+/**
+  \class    pat::ConstituentView ConstituentView.h "DataFormats/PatCandidates/interface/ConstituentView.h"
+  \brief    Read-only view over constituents of a PAT object, whatever the way they are stored
+
+   The constituents of a PAT object (the calo towers and PF candidates of a pat::Jet, the tracks
+   and PF candidates of a pat::Tau) can be embedded as a collection, possibly through indices
+   into another embedded collection, embedded as a vector of FwdPtrs, referred to by a RefVector,
+   or not embedded at all, in which case they are the daughters of the original composite
+   candidate. The view gives access to them in the same way in all cases, without filling nor
+   caching any vector of Ptrs or Refs: it only holds pointers to the storage of the object, so it
+   is cheap to build on each call and safe to use from several threads reading the same object.
+
+   When the constituents are embedded as a collection, embedded() gives direct access to the
+   contiguous array of the constituents, e.g. to loop over their four-momenta.
+
+   The view and its iterators refer to the storage of the object, so they must not outlive it;
+   the iterators do not refer to the view, which may be a temporary.
+*/
+
+#include "DataFormats/Candidate/interface/CompositePtrCandidate.h"
+#include "DataFormats/Common/interface/Ptr.h"
+#include "DataFormats/Common/interface/FwdPtr.h"
+#include "DataFormats/Common/interface/Ref.h"
+#include "DataFormats/Common/interface/RefVector.h"
+#include "DataFormats/Common/interface/RefToPtr.h"
+#include <boost/cstdint.hpp>
+#include <iterator>
+#include <vector>
+
+namespace pat {
+
+  template<typename T, typename Collection = std::vector<T> >
+  class ConstituentView {
+    public:
+      typedef const T *                          value_type;
+      typedef size_t                             size_type;
+      typedef std::vector<edm::FwdPtr<T> >       FwdPtrVector;
+      typedef edm::Ref<Collection>               Ref;
+      typedef edm::RefVector<Collection>         RefVector;
+
+      /// storage of the constituents, shared by the view and its iterators
+      struct Source {
+        Source() : embedded(0), indices(0), fwdPtrs(0), refs(0), mother(0), collection(0) {}
+        /// constituent by index (no range check); NULL if a daughter of the mother is not of type T
+        const T * get(size_t idx) const {
+          if (embedded != 0) return embedded + (indices != 0 ? (*indices)[idx] : idx);
+          if (fwdPtrs  != 0) return (*fwdPtrs)[idx].get();
+          if (refs     != 0) return (*refs)[idx].get();
+          if (mother   != 0) return dynamic_cast<const T *>(mother->reco::CompositePtrCandidate::daughter(idx));
+          return 0;
+        }
+        bool operator==(const Source & other) const {
+          return embedded == other.embedded && indices == other.indices && fwdPtrs == other.fwdPtrs &&
+                 refs == other.refs && mother == other.mother && collection == other.collection;
+        }
+        const T *                           embedded;
+        const std::vector<uint16_t> *       indices;
+        const FwdPtrVector *                fwdPtrs;
+        const RefVector *                   refs;
+        const reco::CompositePtrCandidate * mother;
+        const Collection *                  collection;
+      };
+
+      /// iterator over the constituents; dereferencing gives a pointer to the constituent
+      class const_iterator {
+        public:
+          typedef std::random_access_iterator_tag  iterator_category;
+          typedef const T *                        value_type;
+          typedef ptrdiff_t                        difference_type;
+          typedef const value_type *               pointer;
+          typedef value_type                       reference;
+          const_iterator() : idx_(0) {}
+          const_iterator(const Source & source, size_t idx) : source_(source), idx_(idx) {}
+          reference operator*() const { return source_.get(idx_); }
+          reference operator[](difference_type n) const { return source_.get(idx_ + n); }
+          const_iterator & operator++() { ++idx_; return *this; }
+          const_iterator operator++(int) { const_iterator ret(*this); ++idx_; return ret; }
+          const_iterator & operator--() { --idx_; return *this; }
+          const_iterator operator--(int) { const_iterator ret(*this); --idx_; return ret; }
+          const_iterator & operator+=(difference_type n) { idx_ += n; return *this; }
+          const_iterator & operator-=(difference_type n) { idx_ -= n; return *this; }
+          const_iterator operator+(difference_type n) const { return const_iterator(source_, idx_ + n); }
+          const_iterator operator-(difference_type n) const { return const_iterator(source_, idx_ - n); }
+          difference_type operator-(const const_iterator & other) const { return difference_type(idx_) - difference_type(other.idx_); }
+          bool operator==(const const_iterator & other) const { return idx_ == other.idx_ && source_ == other.source_; }
+          bool operator!=(const const_iterator & other) const { return !(*this == other); }
+          bool operator<(const const_iterator & other) const { return idx_ < other.idx_; }
+        private:
+          Source source_;
+          size_t idx_;
+      };
+
+      /// empty view
+      ConstituentView() : size_(0) {}
+      /// view over all the constituents embedded as a collection
+      explicit ConstituentView(const Collection & embedded) : size_(embedded.size()) {
+        source_.embedded = (embedded.empty() ? 0 : &*embedded.begin());
+        source_.collection = &embedded;
+      }
+      /// view over the constituents embedded as a collection at the given indices
+      ConstituentView(const Collection & embedded, const std::vector<uint16_t> & indices) : size_(indices.size()) {
+        source_.embedded = (embedded.empty() ? 0 : &*embedded.begin());
+        source_.indices = &indices;
+        source_.collection = &embedded;
+      }
+      /// view over constituents embedded as FwdPtrs
+      explicit ConstituentView(const FwdPtrVector & fwdPtrs) : size_(fwdPtrs.size()) { source_.fwdPtrs = &fwdPtrs; }
+      /// view over constituents which are not embedded, referred to by Refs
+      explicit ConstituentView(const RefVector & refs) : size_(refs.size()) { source_.refs = &refs; }
+      /// view over the daughters of the original composite candidate
+      explicit ConstituentView(const reco::CompositePtrCandidate & mother) :
+        size_(mother.reco::CompositePtrCandidate::numberOfDaughters()) { source_.mother = &mother; }
+
+      /// number of constituents
+      size_t size()  const { return size_; }
+      /// true if there are no constituents
+      bool   empty() const { return size_ == 0; }
+      /// constituent by index (no range check); NULL if a daughter of the mother is not of type T
+      const T * operator[](size_t idx) const { return source_.get(idx); }
+      /// edm::Ptr to a constituent; if the constituents are embedded as a collection,
+      /// the Ptr is transient only and must not be persisted
+      edm::Ptr<T> ptr(size_t idx) const {
+        if (source_.collection != 0) return edm::Ptr<T>(source_.collection, key(idx));
+        if (source_.fwdPtrs    != 0) return (*source_.fwdPtrs)[idx].ptr();
+        if (source_.refs       != 0) return edm::refToPtr((*source_.refs)[idx]);
+        if (source_.mother     != 0) {
+          reco::CandidatePtr dau = source_.mother->daughterPtr(idx);
+          const T * item = dynamic_cast<const T *>(dau.get());
+          return (item != 0 ? edm::Ptr<T>(dau.id(), item, dau.key()) : edm::Ptr<T>());
+        }
+        return edm::Ptr<T>();
+      }
+      /// edm::Ref to a constituent embedded as a collection or referred to by a Ref, null otherwise;
+      /// if the constituents are embedded, the Ref is transient only and must not be persisted
+      Ref ref(size_t idx) const {
+        if (source_.collection != 0) return Ref(source_.collection, key(idx));
+        if (source_.refs       != 0) return (*source_.refs)[idx];
+        return Ref();
+      }
+      const_iterator begin() const { return const_iterator(source_, 0); }
+      const_iterator end()   const { return const_iterator(source_, size_); }
+
+      /// true if the constituents are embedded as a collection
+      bool isEmbedded() const { return source_.collection != 0; }
+      /// contiguous array of the constituents if they are all embedded as a collection, NULL otherwise
+      const T * embedded() const { return source_.indices == 0 ? source_.embedded : 0; }
+
+    private:
+      size_t key(size_t idx) const { return source_.indices != 0 ? (*source_.indices)[idx] : idx; }
+
+      Source  source_;
+      size_t  size_;
+  };
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef DataFormats_PatCandidates_DiscriminatorSchema_h
+#define DataFormats_PatCandidates_DiscriminatorSchema_h
+
+/**
+  \class    pat::DiscriminatorSchema DiscriminatorSchema.h "DataFormats/PatCandidates/interface/DiscriminatorSchema.h"
+  \brief    Names of the discriminators stored by all the objects of a collection, one slot per name
+
+   The objects of a collection store their discriminators as a flat vector of floats, in the
+   order of the slots of a schema which is stored once per event and shared by all of them,
+   instead of one copy of each discriminator name per object.
+
+   pat::DiscriminatorHandle keeps the slot of a discriminator found in the last schema, so the
+   following accesses for the objects sharing the same schema cost one check of the name in
+   that slot and a plain vector indexing.
+*/
+
+#include "DataFormats/Common/interface/RefProd.h"
+#include <string>
+#include <vector>
+
+namespace pat {
+
+  class DiscriminatorSchema {
+    public:
+      DiscriminatorSchema() {}
+      explicit DiscriminatorSchema(const std::vector<std::string> & names) : names_(names) {}
+
+      /// slot of the discriminator with the given name, adding it if not yet there
+      unsigned int add(const std::string & name) {
+        int slot = index(name);
+        if (slot >= 0) return slot;
+        names_.push_back(name);
+        return names_.size() - 1;
+      }
+      /// slot of the discriminator with the given name, -1 if there is none
+      int index(const std::string & name) const {
+        for (std::vector<std::string>::const_iterator it = names_.begin(), ed = names_.end(); it != ed; ++it) {
+          if (*it == name) return it - names_.begin();
+        }
+        return -1;
+      }
+      /// number of slots
+      unsigned int size() const { return names_.size(); }
+      /// name of the discriminator in a slot
+      const std::string & name(unsigned int slot) const { return names_[slot]; }
+      /// names of the discriminators, in the order of the slots
+      const std::vector<std::string> & names() const { return names_; }
+
+    private:
+      std::vector<std::string> names_;
+  };
+
+  typedef edm::RefProd<DiscriminatorSchema> DiscriminatorSchemaRefProd;
+
+  class DiscriminatorHandle {
+    public:
+      explicit DiscriminatorHandle(const std::string & label) : label_(label), slot_(-1) {}
+
+      /// name of the discriminator
+      const std::string & label() const { return label_; }
+      /// slot of the discriminator in the given schema, -1 if it is not there; the slot found
+      /// in the previous call is kept if it holds the same name in this schema, otherwise the
+      /// name is looked up. The schema address is not used as a key, since the memory of a
+      /// schema can be reused by a different one (e.g. in the next event)
+      int slot(const DiscriminatorSchema * schema) {
+        if (schema == 0) return -1;
+        if (slot_ >= 0 && (unsigned int)slot_ < schema->size() && schema->name(slot_) == label_) return slot_;
+        slot_ = schema->index(label_);
+        return slot_;
+      }
+
+    private:
+      std::string label_;
+      int slot_;
+  };
+
+}
+
+#endif
@@ -29,6 +29,9 @@
 #include "DataFormats/PatCandidates/interface/Lepton.h"
 
 #include "DataFormats/EcalRecHit/interface/EcalRecHitCollections.h"
+#include "DataFormats/PatCandidates/interface/RecHitFootprint.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
+#include "DataFormats/PatCandidates/interface/IdStore.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 
@@ -69,6 +72,11 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual Electron * clone() const { return new Electron(*this); }
 
+      /// Add the memory used by the embedded electron content, IDs and impact parameters to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+      /// Round the impact parameters to the precision of the policy, in addition to the lepton payloads
+      virtual void reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) ;
+
       // ---- methods for content embedding ----
       /// override the virtual reco::GsfElectron::core method, so that the embedded core can be used by GsfElectron client methods
       virtual reco::GsfElectronCoreRef core() const;
@@ -117,6 +125,13 @@ namespace pat {
       void embedTrack();
       /// method to store the RecHits internally - can be called from the PATElectronProducer
       void embedRecHits(const EcalRecHitCollection * rechits); 
+      /// method to store internally only the RecHits inside a window (see RecHitFootprint.h),
+      /// instead of the whole collection
+      void embedRecHitFootprint(const EcalRecHitCollection * rechits, const std::vector<DetId> & window);
+      /// method to store internally only the RecHits within seedHalfWidth crystals of the seed
+      /// (2 for 5x5) and, if superClusterHalo >= 0, the RecHits of the supercluster crystals and
+      /// within superClusterHalo crystals of them
+      void embedRecHitFootprint(const EcalRecHitCollection * rechits, int seedHalfWidth, int superClusterHalo = -1);
 
       // ---- methods for electron ID ----
       /// Returns a specific electron ID associated to the pat::Electron given its name
@@ -135,15 +150,45 @@ namespace pat {
       // Note: an exception is thrown if the specified ID is not available
       float electronID(const std::string& name) const;
       float electronID(const char* name) const { return electronID( std::string(name) );}
+      /// Returns the electron ID of the handle; the slot of the ID is looked up once per schema.
+      /// Note: an exception is thrown if the specified ID is not available
+      float electronID(DiscriminatorHandle & handle) const;
+      /// Sets value to the electron ID with the given name; returns false, without throwing, if it is not available
+      bool electronID(const std::string& name, float & value) const;
+      /// Sets value to the electron ID of the handle; returns false, without throwing, if it is not available
+      bool electronID(DiscriminatorHandle & handle, float & value) const;
       /// Returns true if a specific ID is available in this pat::Electron
       bool isElectronIDAvailable(const std::string& name) const;
       bool isElectronIDAvailable(const char* name) const {
 	return isElectronIDAvailable(std::string(name));
       }
+      bool isElectronIDAvailable(DiscriminatorHandle & handle) const { float value; return electronID(handle, value); }
+      /// Returns true if the electron passes all the working points of the mask: a single test of the packed
+      /// booleans when they are all in the schema, otherwise each ID must be available and true
+      bool passElectronIDs(IdMask & mask) const { return IdPairs<float>::passes(electronIDStore_, electronIDs_, mask); }
+      /// Sets pass[i] to 1 for the electrons passing all the working points of the mask, 0 otherwise
+      static void passElectronIDs(const std::vector<Electron> & electrons, IdMask & mask, std::vector<unsigned char> & pass) {
+        IdStore::passAll(electrons, &Electron::electronIDStore, &Electron::passElectronIDs, mask, pass);
+      }
       /// Returns all the electron IDs in the form of <name,value> pairs. The 'default' ID is the first in the list
-      const std::vector<IdPair> &  electronIDs() const { return electronIDs_; }
+      const std::vector<IdPair> &  electronIDs() const { return electronIDPairs_.all(electronIDStore_, electronIDs_); }
+      /// Returns the electron IDs stored by slot of the schema of the collection
+      const pat::IdStore & electronIDStore() const { return electronIDStore_; }
       /// Store multiple electron ID values, discarding existing ones. The first one in the list becomes the 'default' electron id
-      void setElectronIDs(const std::vector<IdPair> & ids) { electronIDs_ = ids; }
+      /// With a schema, all the names must be in the schema; schemaContent is the schema object,
+      /// needed in the module producing it, where the RefProd can not be dereferenced yet
+      void setElectronIDs(const std::vector<IdPair> & ids, const IdSchema * schemaContent = 0) {
+        electronIDPairs_.set(electronIDStore_, electronIDs_, ids, schemaContent, "pat::Electron");
+      }
+      /// Set the ID schema of the collection; the IDs already stored are moved to their slots, looked up
+      /// in schemaContent if given (the schema object, which is not kept), otherwise through the RefProd
+      void setElectronIDSchema(const IdSchemaRefProd & schema, const IdSchema * schemaContent = 0) {
+        electronIDPairs_.setSchema(electronIDStore_, electronIDs_, schema, schemaContent, "pat::Electron");
+      }
+      /// Set the electron ID in a slot of the schema (schemaContent: as for setElectronIDs)
+      void setElectronID(unsigned int slot, float value, const IdSchema * schemaContent = 0) {
+        electronIDPairs_.set(electronIDStore_, slot, value, schemaContent);
+      }
 
       // ---- overload of isolation functions ----
       /// Overload of pat::Lepton::trackIso(); returns the value of the summed track pt in a cone of deltaR<0.4
@@ -202,7 +247,10 @@ namespace pat {
       /// set missing mva input variables
       void setMvaVariables( double r9, double sigmaIphiIphi, double sigmaIetaIphi, double ip3d );
 
-      const EcalRecHitCollection * recHits() const { return &recHits_;}
+      /// embedded RecHits; if only a footprint was embedded, the RecHits of the footprint
+      const EcalRecHitCollection * recHits() const;
+      /// embedded RecHits footprint, with lookup by DetId
+      const pat::RecHitFootprint & recHitFootprint() const { return recHitFootprint_; }
 
       /// additional regression variables
       /// regression1
@@ -276,10 +324,19 @@ namespace pat {
       bool embeddedRecHits_;	
       /// Place to store electron's RecHits internally (5x5 around seed+ all RecHits)
       EcalRecHitCollection recHits_;
+      /// Place to store the RecHits inside a window only
+      pat::RecHitFootprint recHitFootprint_;
+      /// transient RecHits of the footprint, unpacked for the users of recHits()
+      mutable EcalRecHitCollection recHitFootprintUnpacked_;
+      pat::CacheState isRecHitFootprintUnpacked_;
 
       // ---- electron ID's holder ----
       /// Electron IDs
       std::vector<IdPair> electronIDs_;
+      /// Electron IDs by slot of the schema of the collection (used instead of electronIDs_ when it has a schema)
+      pat::IdStore electronIDStore_;
+      /// access by name to electronIDStore_ or electronIDs_ (transient)
+      pat::IdPairs<float> electronIDPairs_;
 
       // ---- PF specific members ----
       bool isPF_;
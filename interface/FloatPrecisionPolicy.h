@@ -0,0 +1,70 @@
+#ifndef DataFormats_PatCandidates_FloatPrecisionPolicy_h
+#define DataFormats_PatCandidates_FloatPrecisionPolicy_h
+
+/**
+  \class    pat::FloatPrecisionPolicy FloatPrecisionPolicy.h "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
+  \brief    Number of mantissa bits kept for each floating point payload of the PAT objects
+
+   Most floating point payloads of the PAT objects (user floats, b-tag discriminators, jet
+   energy correction factors, isolations, resolution covariances, impact parameters) do not need
+   the 23 mantissa bits of a float. Rounding them to fewer bits before they are written zeroes
+   the low bits, which the compression of the ROOT baskets then removes almost for free.
+
+   The policy holds the number of mantissa bits to keep for each of these members; the objects
+   apply it in their reduceFloatPrecision method. The policy is persistent, so that the producer
+   which applies it can also put it in the event or run and the files record the precision used.
+   The default policy keeps the full precision.
+*/
+
+#include <string>
+#include <vector>
+
+namespace pat {
+
+  class FloatPrecisionPolicy {
+    public:
+      /// the members the policy applies to
+      enum Member { UserFloats=0, BDiscriminators, JecFactors, Isolations, KinResolutions, ImpactParameters,
+                    NumberOfMembers };
+      /// number of mantissa bits of a float
+      static const unsigned int FullPrecision = 23;
+
+      /// default constructor; all members are kept at full precision
+      FloatPrecisionPolicy() : mantissaBits_(NumberOfMembers, FullPrecision) {}
+
+      /// number of mantissa bits kept for a member
+      unsigned int mantissaBits(Member member) const { return member < mantissaBits_.size() ? mantissaBits_[member] : FullPrecision; }
+      /// set the number of mantissa bits kept for a member, between 1 and 23
+      void setMantissaBits(Member member, unsigned int bits) ;
+      /// set the number of mantissa bits kept for a member given by name (see memberName)
+      void setMantissaBits(const std::string & member, unsigned int bits) ;
+      /// true if all the members are kept at full precision
+      bool isLossless() const ;
+
+      /// name of a member, as used in the configuration and in the reports
+      static const char * memberName(Member member) ;
+      /// member with the given name; false if there is none
+      static bool member(const std::string & name, Member & member) ;
+
+      /// round a value to the nearest float with the given number of mantissa bits;
+      /// infinities and NaNs are left unchanged, and finite values never round to an infinity
+      static float reduceMantissa(float value, unsigned int bits) ;
+      /// round a value of a member
+      float reduce(Member member, float value) const { return reduceMantissa(value, mantissaBits(member)); }
+      /// round a value of a member stored in double precision; left unchanged if the member is kept at full precision
+      double reduce(Member member, double value) const {
+        const unsigned int bits = mantissaBits(member);
+        return bits < FullPrecision ? reduceMantissa(float(value), bits) : value;
+      }
+      /// round all the values of a member
+      void reduce(Member member, std::vector<float> & values) const ;
+      /// round all the values of a member stored in double precision; left unchanged if the member is kept at full precision
+      void reduce(Member member, std::vector<double> & values) const ;
+
+    private:
+      std::vector<unsigned char> mantissaBits_;
+  };
+
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef DataFormats_PatCandidates_GenJetSummary_h
+#define DataFormats_PatCandidates_GenJetSummary_h
+
+/**
+  \class    pat::GenJetSummary GenJetSummary.h "DataFormats/PatCandidates/interface/GenJetSummary.h"
+  \brief    Fixed-size summary of the generator level jet matched to a pat::Jet, and of its flavour
+
+   The summary keeps the four-momentum of the matched generator level jet, its index in the
+   generator level jet collection and its distance in (eta, phi) to the reco jet, together with
+   the parton and hadron flavour of the jet. It is filled at matching time and stored in the jet,
+   so the kinematics and the flavour are available without dereferencing the generator level jet
+   or embedding a full copy of it with its constituents; pat::Jet::genJet() still gives the full
+   generator level jet when the reference or the embedded copy is there.
+*/
+
+#include "DataFormats/Candidate/interface/Candidate.h"
+
+namespace pat {
+
+  struct GenJetSummary {
+    GenJetSummary() :
+      pt(0), eta(0), phi(0), mass(0), deltaR(-1), genJetIndex(-1), partonFlavour(0), hadronFlavour(0) {}
+
+    /// true if a generator level jet was matched
+    bool hasGenJet() const { return genJetIndex >= 0; }
+    /// four-momentum of the matched generator level jet in polar coordinates
+    reco::Candidate::PolarLorentzVector polarP4() const { return reco::Candidate::PolarLorentzVector(pt, eta, phi, mass); }
+    /// four-momentum of the matched generator level jet in cartesian coordinates
+    reco::Candidate::LorentzVector p4() const { return reco::Candidate::LorentzVector(polarP4()); }
+
+    // ---- matched generator level jet ----
+    float pt;
+    float eta;
+    float phi;
+    float mass;
+    float deltaR;       // distance in (eta, phi) to the reco jet at matching time, -1 if none
+    int   genJetIndex;  // index in the generator level jet collection, -1 if none
+    // ---- flavour ----
+    int   partonFlavour;
+    int   hadronFlavour;
+  };
+
+}
+
+#endif
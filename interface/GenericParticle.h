@@ -57,6 +57,9 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual GenericParticle * clone() const { return new GenericParticle(*this); }
 
+      /// Add the memory used by the embedded tracks, clusters, isolation and vertex associations to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+
       /// Checks for overlap with another candidate. 
       /// It will return 'true' if the other candidate is a RecoCandidate, 
       /// and if they reference to at least one same non null track, supercluster or calotower (except for the multiple tracks)
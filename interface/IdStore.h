@@ -0,0 +1,342 @@
+#ifndef DataFormats_PatCandidates_IdStore_h
+#define DataFormats_PatCandidates_IdStore_h
+
+/**
+  \class    pat::IdStore IdStore.h "DataFormats/PatCandidates/interface/IdStore.h"
+  \brief    Identification values of a PAT object, stored by slot of a per-collection pat::IdSchema
+
+   The schema is stored once per event and shared by all the objects of a collection. It gives
+   for each ID its name and its kind: the boolean working points of an object are packed in one
+   64-bit word, and the continuous outputs (e.g. MVA values) are stored in a contiguous float
+   column, without any copy of the names in the object.
+
+   The values are read through a pat::DiscriminatorHandle, which looks up the slot of an ID
+   once for a given schema, and through get methods which report a missing ID by their return
+   value instead of throwing.
+
+   The store only refers to the schema through its RefProd. In the module producing the schema,
+   where the RefProd can not be dereferenced before the schema is put in the event, the methods
+   filling the store take the schema object itself as an optional argument, which is not kept.
+   The schema product must be kept by the keep statements of the output module together with the
+   objects: if it was dropped, the store reads as having no ID, and the get methods return false.
+
+   pat::IdPairs gives the access by name to the IDs of an object which stores them either in an
+   IdStore or, without schema, as (name, value) pairs, as in the files written before the schema.
+
+   A pat::IdMask holds a combination of boolean working points; with a schema in which all of
+   them are packed, it becomes one 64-bit mask, and an object passes them all if the bits of the
+   mask are set in its word. The boolean IDs are either declared as such when the schema is filled,
+   or detected from the values they take over the collection.
+*/
+
+#include "DataFormats/PatCandidates/interface/DiscriminatorSchema.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
+#include "DataFormats/Common/interface/RefProd.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include <boost/cstdint.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pat {
+
+  class IdSchema {
+    public:
+      enum Kind { Float = 0, Boolean = 1 };
+      /// number of boolean IDs which fit in the word of an object
+      static const unsigned int MaxBooleans = 64;
+
+      IdSchema() : nFloats_(0), nBooleans_(0) {}
+
+      /// slot of the ID with the given name, adding it if not yet there; boolean IDs beyond
+      /// the first MaxBooleans are stored in the float column as 0 or 1
+      unsigned int add(const std::string & name, Kind kind = Float) ;
+      /// as add(), with the kind detected from the values of the ID over the collection
+      unsigned int addDetected(const std::string & name, const std::vector<float> & values) {
+        return add(name, isBoolean(values) ? Boolean : Float);
+      }
+      /// true if all the values are 0 or 1
+      static bool isBoolean(const std::vector<float> & values) ;
+      /// slot of the ID with the given name, -1 if there is none
+      int index(const std::string & name) const { return slots_.index(name); }
+      /// slot of the ID of the handle, -1 if there is none
+      int slot(DiscriminatorHandle & handle) const { return handle.slot(&slots_); }
+      /// number of slots
+      unsigned int size() const { return slots_.size(); }
+      /// name of the ID in a slot
+      const std::string & name(unsigned int slot) const { return slots_.name(slot); }
+      /// names of the IDs, in the order of the slots
+      const std::vector<std::string> & names() const { return slots_.names(); }
+      /// kind of the ID in a slot
+      Kind kind(unsigned int slot) const { return Kind(kinds_[slot]); }
+      /// position of the ID of a slot in the float column, or its bit in the boolean word
+      unsigned int position(unsigned int slot) const { return positions_[slot]; }
+      /// number of IDs stored in the float column
+      unsigned int nFloats() const { return nFloats_; }
+      /// number of IDs stored in the boolean word
+      unsigned int nBooleans() const { return nBooleans_; }
+
+    private:
+      DiscriminatorSchema       slots_;
+      std::vector<uint8_t>      kinds_;     // one per slot
+      std::vector<unsigned int> positions_; // one per slot
+      unsigned int              nFloats_;
+      unsigned int              nBooleans_;
+  };
+
+  typedef edm::RefProd<IdSchema> IdSchemaRefProd;
+
+  class IdMask;
+
+  class IdStore {
+    public:
+      IdStore() : booleans_(0), booleansSet_(0) {}
+
+      /// schema of the collection, read through the RefProd; null if none was set, or if the
+      /// schema product is not available in the event (e.g. dropped when writing the file)
+      const IdSchema * schema() const { return (schema_.isNonnull() && schema_.isAvailable() ? schema_.get() : 0); }
+      /// true if a schema was set (without reading it); the schema may still not be available
+      bool hasSchema() const { return schema_.isNonnull(); }
+      /// set the schema of the collection, discarding the values stored so far
+      void setSchema(const IdSchemaRefProd & schema) ;
+      /// remove all the values, keeping the schema
+      void clear() ;
+
+      /// set the value of the ID in a slot of the schema; a boolean ID is true if value > 0.5.
+      /// schemaContent, if given, is the schema the RefProd refers to (in the module producing it)
+      void set(unsigned int slot, float value, const IdSchema * schemaContent = 0) ;
+      /// true if the ID of a slot has a value for this object
+      bool isSet(unsigned int slot) const ;
+      /// value of the ID in a slot, booleans as 0 or 1; false if the ID has no value
+      bool get(unsigned int slot, float & value) const ;
+      /// value of the ID of the handle; false if the ID is not in the schema or has no value
+      bool get(DiscriminatorHandle & handle, float & value) const ;
+      /// value of the ID with the given name; false if the ID is not in the schema or has no value
+      bool get(const std::string & name, float & value) const ;
+      /// (name, value) pairs of the IDs which have a value, in the order of the slots
+      void fillPairs(std::vector<std::pair<std::string, float> > & pairs) const ;
+
+      /// float column, in the order of the positions of the schema; values not set are NaN
+      const std::vector<float> & floats() const { return floats_; }
+      /// boolean word, one bit per position of the schema
+      uint64_t booleans() const { return booleans_; }
+      /// bits of the boolean word which have been set
+      uint64_t booleansSet() const { return booleansSet_; }
+      /// true if all the bits of the mask are true in the boolean word
+      bool passes(uint64_t mask) const { return (booleans_ & mask) == mask; }
+
+      /// pass[i] = 1 if all the bits of masks[i] are set in words[i], 0 otherwise; the loop has no
+      /// branch, so that it can be vectorized over the words gathered from a collection
+      static void passes(const uint64_t * words, const uint64_t * masks, size_t n, unsigned char * pass) ;
+      /// pass[i] = 1 if objects[i] passes all the working points of the mask, 0 otherwise; idStore gives
+      /// the IdStore of an object, and passOne tests an object whose working points are not all packed.
+      /// The words and masks are gathered first, so that the test itself runs over contiguous arrays
+      template<typename T>
+      static void passAll(const std::vector<T> & objects, const IdStore & (T::*idStore)() const,
+                          bool (T::*passOne)(IdMask &) const, IdMask & mask, std::vector<unsigned char> & pass) ;
+
+    private:
+      IdSchemaRefProd    schema_;
+      std::vector<float> floats_;
+      uint64_t           booleans_;
+      uint64_t           booleansSet_;
+  };
+
+  /// conversion of the stored IDs to the type of the IDs of an object
+  inline void convertId(float stored, float & value) { value = stored; }
+  inline void convertId(float stored, bool & value) { value = (stored > 0.5f); }
+
+  /// access by name to the IDs of an object stored in an IdStore or as (name, value) pairs;
+  /// holds the transient pairs built from the store
+  template<typename Value>
+  class IdPairs {
+    public:
+      typedef std::pair<std::string, Value> Pair;
+      typedef std::vector<Pair>             Pairs;
+
+      /// value of the ID with the given name, from the store if it has a schema, otherwise from
+      /// the pairs; false if the ID is not available
+      static bool get(const IdStore & store, const Pairs & pairs, const std::string & name, Value & value) ;
+      /// value of the ID of the handle; false if the ID is not available
+      static bool get(const IdStore & store, const Pairs & pairs, DiscriminatorHandle & handle, Value & value) ;
+      /// value of the ID with the given name; throws if it is not available, listing the available IDs
+      Value get(const IdStore & store, const Pairs & pairs, const std::string & name, const char * object) const ;
+      /// all the IDs as (name, value) pairs: the pairs without schema, otherwise built once from the store
+      const Pairs & all(const IdStore & store, const Pairs & pairs) const ;
+
+      /// store the IDs, discarding the existing ones: in the store if it has a schema, which must
+      /// contain all the names, otherwise in the pairs
+      void set(IdStore & store, Pairs & pairs, const Pairs & ids, const IdSchema * schemaContent, const char * object) ;
+      /// set the schema of the store, moving the IDs already stored to their slots
+      void setSchema(IdStore & store, Pairs & pairs, const IdSchemaRefProd & schema, const IdSchema * schemaContent, const char * object) ;
+      /// true if all the working points of the mask pass: one test of the packed booleans when they
+      /// are all in the schema, otherwise each ID must be available and true
+      static bool passes(const IdStore & store, const Pairs & pairs, IdMask & mask) ;
+
+      /// set the ID in a slot of the schema of the store
+      void set(IdStore & store, unsigned int slot, Value value, const IdSchema * schemaContent) {
+        store.set(slot, float(value), schemaContent);
+        cached_.reset();
+      }
+
+    private:
+      mutable Pairs cache_;   // pairs built from the store
+      CacheState    cached_;
+  };
+
+  class IdMask {
+    public:
+      IdMask() {}
+      explicit IdMask(const std::vector<std::string> & labels) ;
+
+      /// require also the working point with the given name
+      void add(const std::string & label) { labels_.push_back(label); handles_.push_back(DiscriminatorHandle(label)); }
+      /// names of the working points
+      const std::vector<std::string> & labels() const { return labels_; }
+      /// true if all the working points are boolean IDs packed in the word of the given schema, and
+      /// then bits is set to their mask; the slots are found through one DiscriminatorHandle per
+      /// working point, which checks them against the names of the schema at each call
+      bool bits(const IdSchema * schema, uint64_t & bits) ;
+
+    private:
+      std::vector<std::string>         labels_;
+      std::vector<DiscriminatorHandle> handles_;
+  };
+
+}
+
+template<typename Value>
+bool pat::IdPairs<Value>::get(const IdStore & store, const Pairs & pairs, const std::string & name, Value & value) {
+  if (store.hasSchema()) {
+    float stored;
+    if (!store.get(name, stored)) return false;
+    convertId(stored, value);
+    return true;
+  }
+  for (typename Pairs::const_iterator it = pairs.begin(), ed = pairs.end(); it != ed; ++it) {
+    if (it->first == name) { value = it->second; return true; }
+  }
+  return false;
+}
+
+template<typename Value>
+bool pat::IdPairs<Value>::get(const IdStore & store, const Pairs & pairs, DiscriminatorHandle & handle, Value & value) {
+  if (!store.hasSchema()) return get(store, pairs, handle.label(), value);
+  float stored;
+  if (!store.get(handle, stored)) return false;
+  convertId(stored, value);
+  return true;
+}
+
+template<typename Value>
+Value pat::IdPairs<Value>::get(const IdStore & store, const Pairs & pairs, const std::string & name, const char * object) const {
+  Value value;
+  if (get(store, pairs, name, value)) return value;
+  const Pairs & ids = all(store, pairs);
+  cms::Exception ex("Key not found");
+  ex << object << ": the ID " << name << " can't be found in this " << object << ".\n";
+  ex << "The available IDs are: ";
+  for (typename Pairs::const_iterator it = ids.begin(), ed = ids.end(); it != ed; ++it) {
+    ex << "'" << it->first << "' ";
+  }
+  ex << ".\n";
+  throw ex;
+}
+
+template<typename Value>
+const typename pat::IdPairs<Value>::Pairs & pat::IdPairs<Value>::all(const IdStore & store, const Pairs & pairs) const {
+  if (!store.hasSchema()) return pairs;
+  if (!cached_.isReady()) {
+    std::vector<std::pair<std::string, float> > stored;
+    store.fillPairs(stored);
+    Pairs built;
+    built.reserve(stored.size());
+    for (std::vector<std::pair<std::string, float> >::const_iterator it = stored.begin(), ed = stored.end(); it != ed; ++it) {
+      Value value;
+      convertId(it->second, value);
+      built.push_back(Pair(it->first, value));
+    }
+    if (cached_.tryStartFill()) {
+      cache_.swap(built);
+      cached_.publish();
+    } else {
+      cached_.waitReady();
+    }
+  }
+  return cache_;
+}
+
+template<typename Value>
+bool pat::IdPairs<Value>::passes(const IdStore & store, const Pairs & pairs, IdMask & mask) {
+  uint64_t bits;
+  if (mask.bits(store.schema(), bits)) return store.passes(bits);
+  const std::vector<std::string> & labels = mask.labels();
+  for (std::vector<std::string>::const_iterator it = labels.begin(), ed = labels.end(); it != ed; ++it) {
+    Value value;
+    if (!get(store, pairs, *it, value) || !(float(value) > 0.5f)) return false;
+  }
+  return true;
+}
+
+template<typename Value>
+void pat::IdPairs<Value>::set(IdStore & store, Pairs & pairs, const Pairs & ids, const IdSchema * schemaContent, const char * object) {
+  if (!store.hasSchema()) {
+    pairs = ids;
+    return;
+  }
+  const IdSchema * schema = (schemaContent != 0 ? schemaContent : store.schema());
+  if (schema == 0) {
+    throw cms::Exception("ProductNotFound") << "The ID schema of this " << object << " is not available.\n";
+  }
+  store.clear();
+  cached_.reset();
+  for (typename Pairs::const_iterator it = ids.begin(), ed = ids.end(); it != ed; ++it) {
+    int slot = schema->index(it->first);
+    if (slot < 0) {
+      throw cms::Exception("InvalidRequest") << "The ID " << it->first << " is not in the ID schema of this " << object << ".\n";
+    }
+    store.set(slot, float(it->second), schema);
+  }
+}
+
+template<typename Value>
+void pat::IdPairs<Value>::setSchema(IdStore & store, Pairs & pairs, const IdSchemaRefProd & schema, const IdSchema * schemaContent, const char * object) {
+  Pairs ids(all(store, pairs));
+  pairs.clear();
+  store.setSchema(schema);
+  cached_.reset();
+  set(store, pairs, ids, schemaContent, object);
+}
+
+template<typename T>
+void pat::IdStore::passAll(const std::vector<T> & objects, const IdStore & (T::*idStore)() const,
+                           bool (T::*passOne)(IdMask &) const, IdMask & mask, std::vector<unsigned char> & pass) {
+  size_t n = objects.size();
+  pass.resize(n);
+  if (n == 0) return;
+  // the bits are looked up again only when the schema changes; within this call the schemas
+  // of the objects stay alive, so their addresses identify them
+  std::vector<uint64_t> words(n), masks(n);
+  const IdSchema * lastSchema = 0;
+  bool packed = false;
+  uint64_t bits = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const IdStore & store = (objects[i].*idStore)();
+    const IdSchema * schema = store.schema();
+    if (i == 0 || schema != lastSchema) {
+      packed = mask.bits(schema, bits);
+      lastSchema = schema;
+    }
+    if (packed) {
+      words[i] = store.booleans();
+      masks[i] = bits;
+    } else {
+      // tested one by one into a one-bit word
+      words[i] = ((objects[i].*passOne)(mask) ? 1 : 0);
+      masks[i] = 1;
+    }
+  }
+  passes(&words[0], &masks[0], n, &pass[0]);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef DataFormats_PatCandidates_JecHandle_h
+#define DataFormats_PatCandidates_JecHandle_h
+
+/**
+   \class    pat::JecHandle JecHandle.h "DataFormats/PatCandidates/interface/JecHandle.h"
+   \brief    Jet energy correction level, flavor and set resolved once into indices
+
+   The jet energy correction accessors of the pat::Jet taking strings look up the set and the level
+   by their labels for every jet. A JecHandle is built once from the labels; the flavor is resolved
+   at construction, the indices of the set and of the level are resolved against the correction
+   factors of the first jet it is used with, and are reused for all the following jets with the same
+   layout, i.e. the same number of sets and of levels in the resolved set, and the labels of the set
+   and of the level at the resolved indices. This costs two string comparisons per jet instead of a
+   search of the labels. If a jet with a different layout is met, the handle is resolved again.
+
+   The handle caches the indices, so it is passed by non-const reference and must not be shared
+   between threads.
+*/
+
+#include "DataFormats/PatCandidates/interface/JetCorrFactors.h"
+
+#include <string>
+#include <vector>
+
+namespace pat {
+
+  class JecHandle {
+
+  public:
+    // constructor from the labels of the level, the flavor and the set; an empty set label
+    // stands for the first set of correction factors
+    JecHandle(const std::string& level, const std::string& flavor="none", const std::string& set="");
+
+    // label of the correction level
+    const std::string& level() const { return level_; }
+    // label of the set of correction factors
+    const std::string& set() const { return set_; }
+    // flavor of the correction
+    JetCorrFactors::Flavor flavor() const { return flavor_; }
+
+    // true if the indices were resolved for sets of correction factors with the same layout:
+    // the same sizes, and the set and level labels of the handle at the resolved indices
+    bool isResolvedFor(const std::vector<JetCorrFactors>& jec) const {
+      return (resolved_ && jec.size()==nSets_ && jec[setIndex_].numberOfCorrectionLevels()==nLevels_ &&
+              (set_.empty() || jec[setIndex_].isJecSet(set_)) && jec[setIndex_].isJecLevel(levelIndex_, level_));
+    }
+    // resolve the indices for the given sets of correction factors; returns false if
+    // the set or the level do not exist
+    bool resolve(const std::vector<JetCorrFactors>& jec);
+    // index of the set of correction factors; valid after a successful resolve
+    unsigned int setIndex() const { return setIndex_; }
+    // index of the correction level; valid after a successful resolve
+    unsigned int levelIndex() const { return levelIndex_; }
+
+  private:
+    // label of the correction level
+    std::string level_;
+    // label of the set of correction factors
+    std::string set_;
+    // flavor of the correction
+    JetCorrFactors::Flavor flavor_;
+    // true if setIndex_ and levelIndex_ have been resolved
+    bool resolved_;
+    // number of sets of correction factors at the last resolve
+    unsigned int nSets_;
+    // number of levels of the resolved set at the last resolve
+    unsigned int nLevels_;
+    // index of the set of correction factors
+    unsigned int setIndex_;
+    // index of the correction level
+    unsigned int levelIndex_;
+  };
+}
+
+#endif
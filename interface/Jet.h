@@ -28,6 +28,7 @@
 #include "DataFormats/TrackReco/interface/TrackFwd.h"
 #include "DataFormats/BTauReco/interface/JetTag.h"
 #include "DataFormats/PatCandidates/interface/PATObject.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
 #include "DataFormats/BTauReco/interface/TrackIPTagInfo.h"
 #include "DataFormats/BTauReco/interface/TrackProbabilityTagInfo.h"
 #include "DataFormats/BTauReco/interface/TrackCountingTagInfo.h"
@@ -35,6 +36,13 @@
 
 #include "DataFormats/BTauReco/interface/SecondaryVertexTagInfo.h"
 #include "DataFormats/PatCandidates/interface/JetCorrFactors.h"
+#include "DataFormats/PatCandidates/interface/JecHandle.h"
+#include "DataFormats/PatCandidates/interface/DiscriminatorSchema.h"
+#include "DataFormats/PatCandidates/interface/ConstituentView.h"
+#include "DataFormats/PatCandidates/interface/ConstituentArrays.h"
+#include "DataFormats/PatCandidates/interface/PackedPFCandidate.h"
+#include "DataFormats/PatCandidates/interface/JetEnergyFractions.h"
+#include "DataFormats/PatCandidates/interface/GenJetSummary.h"
 #include "DataFormats/JetReco/interface/JetID.h"
 
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidateFwd.h"
@@ -43,6 +51,7 @@
 #include "DataFormats/Common/interface/Ptr.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
+#include <typeinfo>
 
 // Define typedefs for convenience
 namespace pat {
@@ -66,6 +75,8 @@ namespace pat {
   typedef std::vector<edm::FwdPtr<reco::BaseTagInfo> > TagInfoFwdPtrCollection;
   typedef std::vector<edm::FwdPtr<reco::PFCandidate> > PFCandidateFwdPtrCollection;
   typedef std::vector<edm::FwdPtr<CaloTower> > CaloTowerFwdPtrCollection;
+  typedef ConstituentView<reco::PFCandidate, reco::PFCandidateCollection> PFConstituentView;
+  typedef ConstituentView<CaloTower, CaloTowerCollection> CaloConstituentView;
 
 
   class Jet : public PATObject<reco::Jet> {
@@ -89,6 +100,11 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual Jet * clone() const { return new Jet(*this); }
 
+      /// Add the memory used by the jet constituents, tagging information, corrections and specifics to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+      /// Round the b-tag discriminators and the jet energy correction factors to the precision of the policy
+      virtual void reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) ;
+
       /// ---- methods for MC matching ----
 
       /// return the matched generated parton
@@ -97,6 +113,13 @@ namespace pat {
       const reco::GenJet * genJet() const;
       /// return the flavour of the parton underlying the jet
       int partonFlavour() const;
+      /// return the flavour of the hadron underlying the jet
+      int hadronFlavour() const { return genJetSummary_.hadronFlavour; }
+      /// summary of the matched generated jet (four-momentum, index, deltaR) and of the flavour,
+      /// available without dereferencing or embedding the generated jet
+      const pat::GenJetSummary & genJetSummary() const { return genJetSummary_; }
+      /// return true if a generated jet was matched and summarized
+      bool hasGenJetSummary() const { return genJetSummary_.hasGenJet(); }
 
   public:
       /// ---- methods for jet corrections ----
@@ -116,6 +139,8 @@ namespace pat {
       /// returns true if the jet carries a set of jet energy correction
       /// factors with the given label
       bool jecSetAvailable(const unsigned int& set) const {return (set<jec_.size()); };
+      /// returns the set of jet energy correction factors with the given index
+      const JetCorrFactors& jecCorrFactors(const unsigned int& set) const { return jec_.at(set); }
       /// returns the label of the current set of jet energy corrections
       std::string currentJECSet() const { return currentJECSet_<jec_.size() ? jec_.at(currentJECSet_).jecSet() : std::string("ERROR"); }
       /// return the name of the current step of jet energy corrections
@@ -128,6 +153,11 @@ namespace pat {
       /// correction factor to the given level for a specific set
       /// of correction factors, starting from the current level
       float jecFactor(const unsigned int& level, const JetCorrFactors::Flavor& flavor=JetCorrFactors::NONE, const unsigned int& set=0) const;
+      /// correction factor to the level, flavor and set of the handle,
+      /// starting from the current level; the handle is resolved against
+      /// the correction factors of this jet only if they have a different
+      /// layout than the ones it was last resolved for
+      float jecFactor(JecHandle& handle) const;
       /// copy of the jet corrected up to the given level for the set
       /// of jet energy correction factors, which is currently in use
       Jet correctedJet(const std::string& level, const std::string& flavor="none", const std::string& set="") const;
@@ -135,16 +165,35 @@ namespace pat {
       /// of jet energy correction factors, which is currently in use
       Jet correctedJet(const unsigned int& level, const JetCorrFactors::Flavor& flavor=JetCorrFactors::NONE, const unsigned int& set=0) const;
       /// p4 of the jet corrected up to the given level for the set
-      /// of jet energy correction factors, which is currently in use
-      const LorentzVector& correctedP4(const std::string& level, const std::string& flavor="none", const std::string& set="") const { return correctedJet(level, flavor, set).p4(); };
+      /// of jet energy correction factors, which is currently in use;
+      /// computed from the correction factors, without copying the jet
+      LorentzVector correctedP4(const std::string& level, const std::string& flavor="none", const std::string& set="") const { return jecFactor(level, flavor, set)*p4(); };
       /// p4 of the jet corrected up to the given level for the set
+      /// of jet energy correction factors, which is currently in use;
+      /// computed from the correction factors, without copying the jet
+      LorentzVector correctedP4(const unsigned int& level, const JetCorrFactors::Flavor& flavor=JetCorrFactors::NONE, const unsigned int& set=0) const { return jecFactor(level, flavor, set)*p4(); };
+      /// pt of the jet corrected up to the given level for the set
+      /// of jet energy correction factors, which is currently in use
+      double correctedPt(const std::string& level, const std::string& flavor="none", const std::string& set="") const { return jecFactor(level, flavor, set)*pt(); };
+      /// pt of the jet corrected up to the given level for the set
       /// of jet energy correction factors, which is currently in use
-      const LorentzVector& correctedP4(const unsigned int& level, const JetCorrFactors::Flavor& flavor=JetCorrFactors::NONE, const unsigned int& set=0) const { return correctedJet(level, flavor, set).p4(); };
+      double correctedPt(const unsigned int& level, const JetCorrFactors::Flavor& flavor=JetCorrFactors::NONE, const unsigned int& set=0) const { return jecFactor(level, flavor, set)*pt(); };
+      /// p4 of the jet corrected up to the level, flavor and set of the handle
+      LorentzVector correctedP4(JecHandle& handle) const { return jecFactor(handle)*p4(); };
+      /// pt of the jet corrected up to the level, flavor and set of the handle
+      double correctedPt(JecHandle& handle) const { return jecFactor(handle)*pt(); };
+      /// correct all the jets of a collection in place up to the level, flavor
+      /// and set of the handle, updating their current level, flavor and set;
+      /// the factors of all the jets are gathered first, with no allocation per jet
+      static void correctJets(std::vector<Jet>& jets, JecHandle& handle);
 
   private:
       /// index of the set of jec factors with given label; returns -1 if no set
       /// of jec factors exists with the given label
       int jecSet(const std::string& label) const;
+      /// resolve the handle against the correction factors of this jet, if
+      /// needed; throws if the set or the level do not exist
+      void resolveJecHandle(JecHandle& handle) const;
       /// update the current JEC set; used by correctedJet
       void currentJECSet(const unsigned int& set) { currentJECSet_=set; };
       /// update the current JEC level; used by correctedJet
@@ -159,8 +208,26 @@ namespace pat {
   public:
       /// ---- methods for accessing b-tagging info ----
 
-      /// get b discriminant from label name
+      /// get b discriminant from label name; returns -1000 if there is none
       float bDiscriminator(const std::string &theLabel) const;
+      /// get b discriminant from a handle, which looks up the slot of the
+      /// discriminator only once for all the jets sharing the same schema;
+      /// the label of the handle must be the full one (no "default")
+      float bDiscriminator(DiscriminatorHandle &handle) const;
+      /// get b discriminant from its slot in the schema of the collection; returns -1000 if it is not set
+      float bDiscriminator(unsigned int slot) const {
+        return (slot < bDiscriminators_.size() && bDiscriminators_[slot] == bDiscriminators_[slot]) ? bDiscriminators_[slot] : -1000.;
+      }
+      /// fill values with the b discriminant of the handle for all the jets
+      /// of a collection (-1000 for the jets without it)
+      static void bDiscriminators(const std::vector<Jet> &jets, DiscriminatorHandle &handle, std::vector<float> &values);
+      /// schema of the b discriminants of the collection, or NULL if the
+      /// discriminants are stored per jet together with their names, or if
+      /// the schema product was not kept in the file (then bDiscriminator
+      /// returns -1000 for all the discriminants stored by slot)
+      const DiscriminatorSchema * bDiscriminatorSchema() const;
+      /// b discriminants, in the order of the slots of the schema; the slots not set are NaN
+      const std::vector<float> & bDiscriminatorValues() const { return bDiscriminators_; }
       /// get vector of paire labelname-disciValue
       const std::vector<std::pair<std::string, float> > & getPairDiscri() const;
       /// check to see if the given tag info is nonzero
@@ -180,8 +247,19 @@ namespace pat {
       /// If the label is empty or not specified, it returns the first tagInfo of that type (if any one exists)
       /// you should omit the 'TagInfos' part from the label
       const reco::SecondaryVertexTagInfo * tagInfoSecondaryVertex(const std::string &label="") const;
-      /// method to add a algolabel-discriminator pair
+      /// method to add a algolabel-discriminator pair; if the jet has a schema,
+      /// the label is looked up in it and the value stored in its slot (in the module
+      /// producing the schema, which can not be read through the RefProd before it is
+      /// put in the event, use setBDiscriminator instead)
       void addBDiscriminatorPair(const std::pair<std::string, float> & thePair);
+      /// set the schema of the b discriminants shared by the jets of the collection.
+      /// Discriminants already stored with their names are moved into the slots of the
+      /// schema, which must contain their labels; they are looked up in schemaContent,
+      /// the object the RefProd refers to, when given (as in the module producing the
+      /// schema), otherwise through the RefProd. schemaContent is not kept by the jet
+      void setBDiscriminatorSchema(const DiscriminatorSchemaRefProd &schema, const DiscriminatorSchema * schemaContent=0);
+      /// set the b discriminant in a slot of the schema
+      void setBDiscriminator(unsigned int slot, float value);
       /// sets a tagInfo with the given name from an edm::Ptr<T> to it.
       /// If the label ends with 'TagInfos', the 'TagInfos' is stripped out.
       void  addTagInfo(const std::string &label,
@@ -201,16 +279,26 @@ namespace pat {
 
       // ---- methods for content embedding ----
 
-      /// method to store the CaloJet constituents internally
+      /// method to store the CaloJet constituents internally; an empty collection
+      /// stores nothing, and the constituents are still the reco::Jet daughters
       void setCaloTowers(const CaloTowerFwdPtrCollection & caloTowers);
-      /// method to store the PFCandidate constituents internally
+      /// method to store the PFCandidate constituents internally; an empty collection
+      /// stores nothing, and the constituents are still the reco::Jet daughters
       void setPFCandidates(const PFCandidateFwdPtrCollection & pfCandidates);
+      /// method to store the PFCandidate constituents as references to an event-level
+      /// pool of slimmed candidates, shared by all the jets of all the collections;
+      /// an empty vector stores nothing, as for setPFCandidates
+      void setPackedPFCandidates(const PackedPFCandidateRefVector & pfCandidates);
       /// method to set the matched parton
       void setGenParton(const reco::GenParticleRef & gp, bool embed=false) { setGenParticleRef(gp, embed); }
       /// method to set the matched generated jet reference, embedding if requested
       void setGenJetRef(const edm::FwdRef<reco::GenJetCollection> & gj);
       /// method to set the flavour of the parton underlying the jet
       void setPartonFlavour(int partonFl);
+      /// method to set the flavour of the hadron underlying the jet
+      void setHadronFlavour(int hadronFl) { genJetSummary_.hadronFlavour = hadronFl; }
+      /// method to set the summary of the matched generated jet; the flavours are taken from it
+      void setGenJetSummary(const pat::GenJetSummary & summary);
 
 
       /// methods for jet ID
@@ -296,6 +384,8 @@ namespace pat {
       /// get the constituents of the CaloJet.
       /// If the caloTowers were embedded, these reference are transient only and must not be persisted
       std::vector<CaloTowerPtr> const & getCaloConstituents () const;
+      /// view over the caloTowers, embedded or not, which does not fill any vector
+      CaloConstituentView caloConstituents () const;
 
       // ---- JPT Jet specific information ----
 
@@ -390,6 +480,11 @@ namespace pat {
       /// neutralMultiplicity
       int neutralMultiplicity () const {return pfSpecific().mNeutralMultiplicity;}
 
+      /// block of the energy fractions (relative to the uncorrected jet energy) and
+      /// multiplicities used by the jet identification; computed once, and again only
+      /// if the jet energy has changed (e.g. after a change of correction level)
+      const JetEnergyFractions & energyFractions () const;
+
       /// convert generic constituent to specific type
       //  static CaloTowerPtr caloTower (const reco::Candidate* fConstituent);
       /// get specific constituent of the CaloJet.
@@ -398,6 +493,18 @@ namespace pat {
       /// get the constituents of the CaloJet.
       /// If the caloTowers were embedded, these reference are transient only and must not be persisted
       std::vector<reco::PFCandidatePtr> const & getPFConstituents () const;
+      /// references to the slimmed PF candidates in the event-level pool, if the
+      /// constituents are stored that way
+      const PackedPFCandidateRefVector & packedPFCandidates () const { return pfCandidatesPool_; }
+      /// view over the PF candidates, embedded or not, which does not fill any vector;
+      /// its embedded() method gives the contiguous array of the embedded PF candidates
+      PFConstituentView pfConstituents () const;
+      /// append the kinematics of the PF candidates of this jet to the arrays, as a new jet;
+      /// call arrays.clear() first to refill them for this jet only
+      void fillPFConstituentArrays (ConstituentArrays & arrays) const;
+      /// fill the arrays with the kinematics of the PF candidates of all the jets of a
+      /// collection, in one pass; the arrays are cleared first
+      static void fillPFConstituentArrays (const std::vector<Jet> & jets, ConstituentArrays & arrays);
 
       /// get a pointer to a Candididate constituent of the jet
       ///    If using refactorized PAT, return that. (constituents size > 0)
@@ -405,17 +512,18 @@ namespace pat {
       ///    Else return the reco Jet number of constituents
       virtual const reco::Candidate * daughter(size_t i) const {
 	if (isCaloJet() || isJPTJet() ) {
-	  if ( embeddedCaloTowers_ ) {
-	    if ( caloTowersFwdPtr_.size() > 0 ) return caloTowersFwdPtr_[i].get();
-	    else if ( caloTowers_.size() > 0 ) return &caloTowers_[i];
-	    else return reco::Jet::daughter(i);
+	  switch ( caloTowersStorage() ) {
+	    case FwdPtrEmbedded:        return caloTowersFwdPtr_[i].get();
+	    case CompatibilityEmbedded: return &caloTowers_[i];
+	    default:                    break;
 	  }
 	}
 	if (isPFJet()) {
-	  if ( embeddedPFCandidates_ ) {
-	    if ( pfCandidatesFwdPtr_.size() > 0 ) return pfCandidatesFwdPtr_[i].get();
-	    else if ( pfCandidates_.size() > 0 ) return &pfCandidates_[i];
-	    else return reco::Jet::daughter(i);
+	  switch ( pfCandidatesStorage() ) {
+	    case FwdPtrEmbedded:        return pfCandidatesFwdPtr_[i].get();
+	    case PoolEmbedded:          return &unpackedPFCandidatePool()[i];
+	    case CompatibilityEmbedded: return &pfCandidates_[i];
+	    default:                    break;
 	  }
 	}
 	return reco::Jet::daughter(i);
@@ -429,22 +537,45 @@ namespace pat {
       ///    Else return the reco Jet number of constituents
       virtual size_t numberOfDaughters() const {
 	if (isCaloJet() || isJPTJet()) {
-	  if ( embeddedCaloTowers_ ) {
-	    if ( caloTowersFwdPtr_.size() > 0 ) return caloTowersFwdPtr_.size();
-	    else if ( caloTowers_.size() > 0 ) return caloTowers_.size();
-	    else return reco::Jet::numberOfDaughters();
+	  switch ( caloTowersStorage() ) {
+	    case FwdPtrEmbedded:        return caloTowersFwdPtr_.size();
+	    case CompatibilityEmbedded: return caloTowers_.size();
+	    default:                    break;
 	  }
 	}
 	if (isPFJet()) {
-	  if ( embeddedPFCandidates_ ) {
-	    if ( pfCandidatesFwdPtr_.size() > 0 ) return pfCandidatesFwdPtr_.size();
-	    else if ( pfCandidates_.size() > 0 ) return pfCandidates_.size();
-	    else return reco::Jet::numberOfDaughters();
+	  switch ( pfCandidatesStorage() ) {
+	    case FwdPtrEmbedded:        return pfCandidatesFwdPtr_.size();
+	    case PoolEmbedded:          return pfCandidatesPool_.size();
+	    case CompatibilityEmbedded: return pfCandidates_.size();
+	    default:                    break;
 	  }
 	}
 	return reco::Jet::numberOfDaughters();
       }
 
+      /// form in which a payload of the jet (calo towers, PF candidates, tagInfos) is stored;
+      /// a jet holds each payload in one form only
+      enum ContentStorage { NotEmbedded = 0,           // constituents as daughters of the reco jet; no tagInfos
+                            CompatibilityEmbedded = 1, // full copies, in files of the old versions of PAT
+                            FwdPtrEmbedded = 2,        // FwdPtrs, as filled by the current producer
+                            PoolEmbedded = 3 };        // references to the event-level pool (PF candidates only)
+      /// form in which the calo towers are stored
+      ContentStorage caloTowersStorage() const {
+	if ( caloTowersStorage_ != UnresolvedStorage ) return ContentStorage(caloTowersStorage_);
+	return (!caloTowersFwdPtr_.empty() ? FwdPtrEmbedded : (!caloTowers_.empty() ? CompatibilityEmbedded : NotEmbedded));
+      }
+      /// form in which the PF candidates are stored
+      ContentStorage pfCandidatesStorage() const {
+	if ( pfCandidatesStorage_ != UnresolvedStorage ) return ContentStorage(pfCandidatesStorage_);
+	return (!pfCandidatesFwdPtr_.empty() ? FwdPtrEmbedded : (!pfCandidates_.empty() ? CompatibilityEmbedded : NotEmbedded));
+      }
+      /// form in which the tagInfos are stored
+      ContentStorage tagInfosStorage() const {
+	if ( tagInfosStorage_ != UnresolvedStorage ) return ContentStorage(tagInfosStorage_);
+	return (!tagInfosFwdPtr_.empty() ? FwdPtrEmbedded : (!tagInfos_.empty() ? CompatibilityEmbedded : NotEmbedded));
+      }
+
       /// accessing Jet ID information
       reco::JetID const & jetID () const { return jetID_;}
 
@@ -477,6 +608,7 @@ namespace pat {
       void updateFwdTagInfoFwdPtr( unsigned int index, edm::Ptr<reco::BaseTagInfo> updateFwd ) {
 	if ( index < tagInfosFwdPtr_.size() ) {
 	  tagInfosFwdPtr_[index] = TagInfoFwdPtrCollection::value_type( updateFwd, tagInfosFwdPtr_[index].backPtr() );
+	  isTagInfoIndexed_.reset();
 	} else {
 	  throw cms::Exception("OutOfRange") << "Index " << index << " is out of range" << std::endl;
 	}
@@ -493,16 +625,22 @@ namespace pat {
 
       // ---- for content embedding ----
 
-      bool embeddedCaloTowers_;
+      /// value of the storage members for jets read from files written before they existed;
+      /// the form is then found from the containers which are filled
+      static const uint8_t UnresolvedStorage = 0xff;
+
+      uint8_t caloTowersStorage_; // ContentStorage of the calo towers
       mutable std::vector<CaloTowerPtr> caloTowersTemp_; // to simplify user interface
       CaloTowerCollection caloTowers_; // Compatibility embedding
       CaloTowerFwdPtrVector caloTowersFwdPtr_; // Refactorized content embedding
 
 
-      bool embeddedPFCandidates_;
+      uint8_t pfCandidatesStorage_; // ContentStorage of the PF candidates
       mutable std::vector<reco::PFCandidatePtr> pfCandidatesTemp_; // to simplify user interface
       reco::PFCandidateCollection pfCandidates_; // Compatibility embedding
       reco::PFCandidateFwdPtrVector pfCandidatesFwdPtr_; // Refactorized content embedding
+      PackedPFCandidateRefVector pfCandidatesPool_; // References to the event-level pool of slimmed candidates
+      mutable reco::PFCandidateCollection pfCandidatesPoolUnpacked_; // transient, unpacked pool candidates
 
 
       // ---- MC info ----
@@ -511,6 +649,7 @@ namespace pat {
       reco::GenJetRefVector genJetRef_;
       edm::FwdRef<reco::GenJetCollection>  genJetFwdRef_;
       int partonFlavour_;
+      pat::GenJetSummary genJetSummary_; // matched generated jet kinematics and flavours, filled at matching time
 
       // ---- energy scale correction factors ----
 
@@ -529,7 +668,11 @@ namespace pat {
 
       // ---- b-tag related members ----
 
-      std::vector<std::pair<std::string, float> >           pairDiscriVector_;
+      std::vector<std::pair<std::string, float> >           pairDiscriVector_; // without schema, and files written before it
+      DiscriminatorSchemaRefProd        bDiscriminatorSchema_;
+      std::vector<float>                bDiscriminators_; // in the order of the slots of bDiscriminatorSchema_
+      mutable std::vector<std::pair<std::string, float> >   pairDiscriTemp_; // for getPairDiscri with a schema
+      uint8_t                           tagInfosStorage_; // ContentStorage of the tagInfos
       std::vector<std::string>          tagInfoLabels_;
       edm::OwnVector<reco::BaseTagInfo> tagInfos_; // Compatibility embedding
       TagInfoFwdPtrCollection  tagInfosFwdPtr_; // Refactorized embedding
@@ -556,6 +699,9 @@ namespace pat {
 
       void tryImportSpecific(const reco::Jet &source);
       template<typename T> const T * tagInfoByType() const;
+      template<typename T> const T * tagInfoByLabel(const std::string &label) const;
+      const reco::BaseTagInfo * tagInfoAt(size_t slot) const;
+      int tagInfoSlot(const std::type_info &type) const;
 
       /// return the jet correction factors of a different set, for systematic studies
       const JetCorrFactors * corrFactors_(const std::string& set) const ;
@@ -563,10 +709,28 @@ namespace pat {
       const JetCorrFactors * corrFactors_() const;
 
       /// cache calo towers
-      mutable bool isCaloTowerCached_;
+      pat::CacheState isCaloTowerCached_;
       void cacheCaloTowers() const;
-      mutable bool isPFCandidateCached_;
+      pat::CacheState isPFCandidateCached_;
       void cachePFCandidates() const;
+      /// number of stored tagInfos
+      size_t tagInfosSize() const { return tagInfosStorage() == CompatibilityEmbedded ? tagInfos_.size() : tagInfosFwdPtr_.size(); }
+      /// cache energy fractions
+      pat::CacheState energyFractionsState_;
+      mutable JetEnergyFractions energyFractions_;
+      mutable double energyFractionsEnergy_; // jet energy when the fractions were computed
+      void fillEnergyFractions(JetEnergyFractions & fractions) const;
+      /// unpack the slimmed candidates of the pool
+      pat::CacheState isPFCandidatePoolUnpacked_;
+      const reco::PFCandidateCollection & unpackedPFCandidatePool() const;
+      /// cache labelname-disciValue pairs
+      pat::CacheState isPairDiscriCached_;
+      /// index of the types of the tagInfos
+      mutable std::vector<const std::type_info *> tagInfoTypes_; // type of each tagInfo
+      mutable std::vector<std::pair<const std::type_info *, unsigned int> > tagInfoTypeSlots_; // first slot of each type
+      pat::CacheState isTagInfoIndexed_;
+      void indexTagInfos() const;
+      void checkTagInfoIndex() const;
 
   };
 }
@@ -31,6 +31,7 @@
 #include <vector>
 #include <string>
 #include <math.h>
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
 
 namespace pat {
 
@@ -62,8 +63,14 @@ namespace pat {
     int jecLevel(const std::string& level) const;
     // jet energy correction flavor from enum
     std::string jecFlavor(const Flavor& flavor) const;
-    // jet energy correction flavor from std::string
-    Flavor jecFlavor(std::string flavor) const;
+    // jet energy correction flavor from std::string (not case sensitive)
+    Flavor jecFlavor(const std::string& flavor) const;
+    // jet energy correction flavor from std::string (not case sensitive); returns false if there is no such flavor
+    static bool jecFlavor(const std::string& flavor, Flavor& result);
+    // true if the label of this set of jet energy correction factors is the given one
+    bool isJecSet(const std::string& label) const { return label_==label; }
+    // true if the correction level with the given index has the given label
+    bool isJecLevel(unsigned int level, const std::string& label) const { return (level<jec_.size() && jec_[level].first==label); }
 
     // correction factor up to a given level and flavor (per default the flavor is NONE)
     float correction(unsigned int level, Flavor flavor=NONE) const;
@@ -77,8 +84,12 @@ namespace pat {
     bool flavorDependent(unsigned int level) const { return (level<jec_.size() ? jec_.at(level).second.size()==MAX_FLAVORS : false); };
     // number of available correction factors
     unsigned int numberOfCorrectionLevels() const { return jec_.size(); };
+    // stored correction factors of a specific level (one per flavor for flavor dependent levels)
+    const std::vector<float>& correctionFactors(unsigned int level) const { return jec_.at(level).second; };
     // print function for debugging
     void print() const;
+    // round the correction factors to the precision of the policy
+    void reduceFloatPrecision(const FloatPrecisionPolicy& policy);
 
   private:
     // check consistency of input vector
@@ -0,0 +1,50 @@
+#ifndef DataFormats_PatCandidates_JetEnergyFractions_h
+#define DataFormats_PatCandidates_JetEnergyFractions_h
+
+/**
+  \class    pat::JetEnergyFractions JetEnergyFractions.h "DataFormats/PatCandidates/interface/JetEnergyFractions.h"
+  \brief    Energy fractions and multiplicities of a jet, as used by the jet identification
+
+   All the fractions are relative to the uncorrected jet energy, as the ones returned by the
+   xxxEnergyFraction() methods of pat::Jet. The block is filled once by pat::Jet::energyFractions(),
+   so the jet identification does not have to divide by the uncorrected energy again and again.
+   The quantities which do not exist for the type of the jet (e.g. the photon fraction of a calo
+   jet) are left to zero.
+*/
+
+namespace pat {
+
+  struct JetEnergyFractions {
+    JetEnergyFractions() :
+      chargedHadron(0), neutralHadron(0), chargedEm(0), neutralEm(0),
+      photon(0), electron(0), muon(0), chargedMu(0), HFHadron(0), HFEM(0),
+      em(0), hadronic(0), fHPD(0),
+      chargedMultiplicity(0), neutralMultiplicity(0), muonMultiplicity(0), nConstituents(0), n90Hits(0) {}
+
+    // ---- PF and JPT jets ----
+    float chargedHadron;
+    float neutralHadron;
+    float chargedEm;
+    float neutralEm;
+    // ---- PF jets ----
+    float photon;
+    float electron;
+    float muon;
+    float chargedMu;
+    float HFHadron;
+    float HFEM;
+    // ---- calo and JPT jets ----
+    float em;        // electromagnetic energy fraction of the calo jet
+    float hadronic;  // hadronic energy fraction of the calo jet
+    float fHPD;      // fraction of energy in the hottest HPD, from the jet ID
+    // ---- multiplicities ----
+    int chargedMultiplicity;
+    int neutralMultiplicity;
+    int muonMultiplicity;
+    int nConstituents;
+    int n90Hits;     // from the jet ID
+  };
+
+}
+
+#endif
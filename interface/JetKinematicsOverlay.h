@@ -0,0 +1,115 @@
+#ifndef DataFormats_PatCandidates_JetKinematicsOverlay_h
+#define DataFormats_PatCandidates_JetKinematicsOverlay_h
+
+/**
+   \class    pat::JetKinematicsOverlay JetKinematicsOverlay.h "DataFormats/PatCandidates/interface/JetKinematicsOverlay.h"
+   \brief    Varied kinematics of a jet collection, for jet energy scale systematics
+
+   Instead of cloning the whole jet collection for each variation of the jet energy scale, the
+   overlay stores the kinematics of the base collection once and, for each of the K variations,
+   only the varied pt and mass of the N jets, in contiguous arrays of K x N floats. A variation
+   is given by one scale factor per jet; as it scales the whole four-momentum, eta and phi are
+   the same for all the variations and are stored only once.
+
+   The jets are addressed by their index in the base collection, so selections can read the
+   varied kinematics without touching the jets, and metShift gives the propagation of a
+   variation to the missing transverse energy.
+*/
+
+#include "DataFormats/Candidate/interface/Candidate.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace pat {
+
+  class JetKinematicsOverlay {
+
+  public:
+    /// change of the missing transverse energy induced by a variation
+    struct MetShift {
+      MetShift() : px(0), py(0), sumEt(0) {}
+      double px, py, sumEt;
+    };
+
+    /// default constructor
+    JetKinematicsOverlay() {}
+    /// constructor from a collection of jets (or of any candidates)
+    template<typename Collection> explicit JetKinematicsOverlay(const Collection& jets) { setJets(jets); }
+
+    /// set the base kinematics from a collection of jets (or of any candidates); removes all the variations
+    template<typename Collection> void setJets(const Collection& jets) ;
+
+    /// add a variation with one scale factor per jet; returns its index
+    unsigned int addVariation(const std::string& name, const std::vector<float>& scales) ;
+    /// add one variation per name, with the scale factors of variation k for jet i at scales[k*nJets()+i];
+    /// returns the index of the first one
+    unsigned int addVariations(const std::vector<std::string>& names, const std::vector<float>& scales) ;
+    /// add a pair of variations name+"Up" and name+"Down", scaling the jets by (1 + uncertainty)
+    /// and (1 - uncertainty), with one relative uncertainty per jet; returns the index of the first one
+    unsigned int addUpDownVariations(const std::string& name, const std::vector<float>& uncertainties) ;
+
+    /// number of jets
+    unsigned int nJets() const { return pt_.size(); }
+    /// number of variations
+    unsigned int nVariations() const { return names_.size(); }
+    /// name of a variation
+    const std::string& variationName(unsigned int k) const { return names_[k]; }
+    /// index of the variation with the given name, -1 if there is none
+    int variationIndex(const std::string& name) const ;
+
+    /// base kinematics of a jet
+    float pt(unsigned int i)   const { return pt_[i]; }
+    float eta(unsigned int i)  const { return eta_[i]; }
+    float phi(unsigned int i)  const { return phi_[i]; }
+    float mass(unsigned int i) const { return mass_[i]; }
+    /// varied kinematics of a jet
+    float pt(unsigned int k, unsigned int i)   const { return variedPt_[k*nJets()+i]; }
+    float eta(unsigned int k, unsigned int i)  const { return eta_[i]; }
+    float phi(unsigned int k, unsigned int i)  const { return phi_[i]; }
+    float mass(unsigned int k, unsigned int i) const { return variedMass_[k*nJets()+i]; }
+    /// varied four-momentum of a jet
+    reco::Candidate::PolarLorentzVector polarP4(unsigned int k, unsigned int i) const {
+      return reco::Candidate::PolarLorentzVector(pt(k,i), eta_[i], phi_[i], mass(k,i));
+    }
+    /// contiguous arrays of nJets() varied pts and masses of a variation, for loops over the jets
+    const float * pts(unsigned int k)    const { return variedPt_.empty() ? 0 : &variedPt_[k*nJets()]; }
+    const float * masses(unsigned int k) const { return variedMass_.empty() ? 0 : &variedMass_[k*nJets()]; }
+
+    /// change of the missing transverse energy for a variation, summed over the jets with a
+    /// varied pt above minPt (the MET moves opposite to the change of the jet momenta)
+    MetShift metShift(unsigned int k, float minPt=0) const ;
+
+  private:
+    /// resize the varied arrays for nVariations more variations; returns the index of the first one
+    unsigned int growVariations(unsigned int nVariations) ;
+
+  private:
+    /// base kinematics, one entry per jet
+    std::vector<float> pt_, eta_, phi_, mass_;
+    /// cos(phi) and sin(phi) of the jets, for the propagation to the MET
+    std::vector<float> cosPhi_, sinPhi_;
+    /// names of the variations
+    std::vector<std::string> names_;
+    /// varied pts and masses, nJets() entries per variation
+    std::vector<float> variedPt_, variedMass_;
+  };
+
+}
+
+template<typename Collection>
+void pat::JetKinematicsOverlay::setJets(const Collection& jets) {
+  pt_.clear(); eta_.clear(); phi_.clear(); mass_.clear(); cosPhi_.clear(); sinPhi_.clear();
+  names_.clear(); variedPt_.clear(); variedMass_.clear();
+  for (typename Collection::const_iterator jet = jets.begin(), ed = jets.end(); jet != ed; ++jet) {
+    pt_.push_back(jet->pt());
+    eta_.push_back(jet->eta());
+    phi_.push_back(jet->phi());
+    mass_.push_back(jet->mass());
+    cosPhi_.push_back(std::cos(jet->phi()));
+    sinPhi_.push_back(std::sin(jet->phi()));
+  }
+}
+
+#endif
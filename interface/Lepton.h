@@ -194,6 +194,11 @@ namespace pat {
       void hcalIsoDeposit(const IsoDeposit &dep)  { setIsoDeposit(pat::HcalIso, dep); }
       void userIsoDeposit(const IsoDeposit &dep, uint8_t index=0) { setIsoDeposit(IsolationKeys(UserBaseIso + index), dep); }
 
+      /// Add the memory used by the isolation data members to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+      /// Round the isolation values to the precision of the policy
+      virtual void reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) ;
+
 
     protected:
       // --- Isolation and IsoDeposit related datamebers ---
@@ -239,6 +244,22 @@ namespace pat {
   template <class LeptonType>
   Lepton<LeptonType>::~Lepton() {
   }
+
+  /// memory footprint
+  template <class LeptonType>
+  void Lepton<LeptonType>::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+    PATObject<LeptonType>::fillMemoryFootprint(report);
+    report.setObjectSize(sizeof(Lepton<LeptonType>));
+    report.addContainer("isolation", isoDeposits_);
+    report.addContainer("isolation", isolations_);
+  }
+
+  /// float precision
+  template <class LeptonType>
+  void Lepton<LeptonType>::reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) {
+    PATObject<LeptonType>::reduceFloatPrecision(policy);
+    policy.reduce(pat::FloatPrecisionPolicy::Isolations, isolations_);
+  }
 }
 
 #endif
@@ -24,6 +24,7 @@
 #include "DataFormats/METReco/interface/PFMET.h"
 #include "DataFormats/METReco/interface/GenMET.h"
 #include "DataFormats/PatCandidates/interface/PATObject.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
 
 
 // Define typedefs for convenience
@@ -57,6 +58,9 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual MET * clone() const { return new MET(*this); }
 
+      /// Add the memory used by the MET specific data and the uncorrected MET cache to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+
       // ---- methods for generated MET link ----
       /// return the associated GenMET
       const reco::GenMET * genMET() const;
@@ -173,12 +177,15 @@ namespace pat {
       mutable std::vector<UncorInfo> uncorInfo_;
       mutable unsigned int nCorrections_;
       mutable float oldPt_;
+      CacheState uncorInfoState_;
       
     protected:
 
       // ---- non-public correction utilities ----
       void checkUncor_() const;
       void setPtPhi_(UncorInfo& uci) const;
+      void fillUncor_(std::vector<UncorInfo> & uncorInfo, unsigned int & nCorrections) const;
+      void storeUncor_(std::vector<UncorInfo> & uncorInfo, unsigned int nCorrections) const;
 
   };
 
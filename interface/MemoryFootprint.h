@@ -0,0 +1,129 @@
+#ifndef DataFormats_PatCandidates_MemoryFootprint_h
+#define DataFormats_PatCandidates_MemoryFootprint_h
+
+/**
+  \class    pat::MemoryFootprint MemoryFootprint.h "DataFormats/PatCandidates/interface/MemoryFootprint.h"
+  \brief    Breakdown of the memory used by a PAT object, by category of data members
+
+   Each category (embedded tracks, PF candidates, trigger matches, user data, labels, ...) records
+   the bytes held inline in the object (the size of the data members themselves) and the bytes
+   allocated on the heap by them. The heap sizes are estimates: containers are counted from their
+   capacity (or size, if they have no capacity) times the size of their elements, so allocations
+   made internally by embedded reco objects (e.g. the clusters of an embedded SuperCluster) and
+   by polymorphic items of an OwnVector are not included.
+
+   The memory not attributed to any category (the base reco object, flags, numbers) is reported
+   as the inline size of the object minus the inline sizes of the categories.
+
+   pat::MemoryFootprintTable sums the reports of many objects, e.g. of a whole collection, and
+   prints a table with the breakdown.
+*/
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+namespace pat {
+
+  namespace memory {
+    /// bytes allocated by a std::vector, from its capacity
+    template<typename T> size_t heapSize(const std::vector<T> & v) { return v.capacity() * sizeof(T); }
+    /// bytes allocated by a std::vector<bool>, which packs the bits
+    inline size_t heapSize(const std::vector<bool> & v) { return v.capacity() / 8; }
+    /// bytes allocated by a std::string
+    inline size_t heapSize(const std::string & s) { return s.capacity(); }
+    /// bytes allocated by a vector of strings, including the strings themselves
+    size_t heapSize(const std::vector<std::string> & v) ;
+    /// bytes allocated by a vector of (string, value) pairs, including the strings
+    template<typename T> size_t heapSize(const std::vector<std::pair<std::string, T> > & v) {
+      size_t ret = v.capacity() * sizeof(std::pair<std::string, T>);
+      for (typename std::vector<std::pair<std::string, T> >::const_iterator it = v.begin(), ed = v.end(); it != ed; ++it) {
+        ret += heapSize(it->first);
+      }
+      return ret;
+    }
+    /// estimate of the bytes used by the items of a container without capacity (RefVector, PtrVector, SortedCollection, OwnVector)
+    template<typename C> size_t itemsSize(const C & c) { return c.size() * sizeof(typename C::value_type); }
+  }
+
+  class MemoryFootprint {
+    public:
+      /// bytes used by one category of data members
+      struct Entry {
+        Entry() : inlineBytes(0), heapBytes(0) {}
+        Entry(const std::string & aCategory, size_t anInline, size_t aHeap) :
+          category(aCategory), inlineBytes(anInline), heapBytes(aHeap) {}
+        std::string category;
+        size_t      inlineBytes;
+        size_t      heapBytes;
+      };
+
+      MemoryFootprint() : objectSize_(0) {}
+
+      /// add bytes to a category, creating it if needed
+      void add(const std::string & category, size_t inlineBytes, size_t heapBytes) ;
+      /// add a std::vector (or std::string) data member to a category
+      template<typename C> void addContainer(const std::string & category, const C & c) {
+        add(category, sizeof(C), memory::heapSize(c));
+      }
+      /// add a data member with no capacity (RefVector, PtrVector, SortedCollection, OwnVector) to a category
+      template<typename C> void addItems(const std::string & category, const C & c) {
+        add(category, sizeof(C), memory::itemsSize(c));
+      }
+      /// set the inline size of the object (sizeof of its most derived type)
+      void setObjectSize(size_t objectSize) { objectSize_ = objectSize; }
+
+      /// categories, in the order they were first filled
+      const std::vector<Entry> & entries() const { return entries_; }
+      /// inline size of the object
+      size_t objectSize() const { return objectSize_; }
+      /// inline bytes not attributed to any category
+      size_t otherInlineBytes() const ;
+      /// total heap bytes
+      size_t heapBytes() const ;
+      /// total bytes, inline and heap
+      size_t totalBytes() const { return objectSize_ + heapBytes(); }
+
+      /// print the breakdown by category
+      void print(std::ostream & out) const ;
+
+    private:
+      std::vector<Entry> entries_;
+      size_t             objectSize_;
+  };
+
+  class MemoryFootprintTable {
+    public:
+      MemoryFootprintTable() : nObjects_(0), objectBytes_(0) {}
+
+      /// add the report of one object
+      void add(const MemoryFootprint & footprint) ;
+      /// add the reports of all the objects of a collection
+      template<typename Collection> void addCollection(const Collection & coll) {
+        for (typename Collection::const_iterator it = coll.begin(), ed = coll.end(); it != ed; ++it) {
+          add(it->memoryFootprint());
+        }
+      }
+      /// forget all the reports
+      void clear() ;
+
+      /// number of objects added
+      size_t nObjects() const { return nObjects_; }
+      /// categories summed over all the objects
+      const std::vector<MemoryFootprint::Entry> & entries() const { return totals_; }
+
+      /// print a table with inline, heap and total bytes per category, the average per object and the fraction of the total
+      void print(std::ostream & out) const ;
+
+    private:
+      std::vector<MemoryFootprint::Entry> totals_;
+      size_t nObjects_;
+      size_t objectBytes_;
+  };
+
+  std::ostream & operator<<(std::ostream & out, const MemoryFootprint & footprint) ;
+  std::ostream & operator<<(std::ostream & out, const MemoryFootprintTable & table) ;
+
+}
+
+#endif
@@ -27,6 +27,7 @@
 
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/PatCandidates/interface/Lepton.h"
+#include "DataFormats/PatCandidates/interface/MuonTrackSummary.h"
 #include "DataFormats/ParticleFlowCandidate/interface/IsolatedPFCandidateFwd.h"
 #include "DataFormats/ParticleFlowCandidate/interface/IsolatedPFCandidate.h"
 
@@ -66,7 +67,20 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual Muon * clone() const { return new Muon(*this); }
 
+      /// Add the memory used by the embedded muon tracks, MET corrections and impact parameters to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+      /// Round the impact parameters to the precision of the policy, in addition to the lepton payloads
+      virtual void reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) ;
+
       // ---- methods for content embedding ----
+      /// roles of the tracks of the muon; the embedded tracks are stored once each, whatever the
+      /// number of roles they have (e.g. the best track is often also the global track)
+      enum TrackRole { BestTrackRole = 0, InnerTrackRole, OuterTrackRole, GlobalTrackRole,
+                       PickyTrackRole, TpfmsTrackRole, DytTrackRole, NumberOfTrackRoles };
+      /// number of distinct tracks embedded for all the roles
+      size_t numberOfEmbeddedTracks() const { return embeddedTracks_.size(); }
+      /// reference to Track selected to be the best measurement of the muon parameters (reimplemented from reco::Muon)
+      reco::TrackRef muonBestTrack() const;
       /// reference to Track reconstructed in the tracker only (reimplemented from reco::Muon)
       reco::TrackRef track() const;
       using reco::RecoCandidate::track; // avoid hiding the base implementation
@@ -147,11 +161,24 @@ namespace pat {
 
       /// Muon Selectors as specified in
       /// https://twiki.cern.ch/twiki/bin/view/CMSPublic/SWGuideMuonId
+      /// The tight, medium and soft selections are evaluated from the track summary if it
+      /// has been filled, without dereferencing the tracks
       bool isTightMuon(const reco::Vertex&) const;
       bool isLooseMuon() const;
+      bool isMediumMuon() const;
       bool isSoftMuon(const reco::Vertex&) const;
       bool isHighPtMuon(const reco::Vertex&) const;
 
+      // ---- track-quality summary ----
+      /// summary of the quality of the inner, global and best tracks, computed from the tracks
+      pat::MuonTrackSummary makeTrackSummary() const;
+      /// compute and store the track summary; to be called at PAT production, while the tracks are available
+      void fillTrackSummary() { trackSummary_ = makeTrackSummary(); }
+      /// true if the track summary has been filled
+      bool hasTrackSummary() const { return trackSummary_.isFilled(); }
+      /// stored track summary (not filled if !hasTrackSummary())
+      const pat::MuonTrackSummary & trackSummary() const { return trackSummary_; }
+
       // ---- overload of isolation functions ----
       /// Overload of pat::Lepton::trackIso(); returns the value of
       /// the summed track pt in a cone of deltaR<0.3
@@ -229,6 +256,14 @@ namespace pat {
 
       // ---- for content embedding ----
 
+      /// embedded tracks, each stored once whatever the number of its roles
+      std::vector<reco::Track> embeddedTracks_;
+      /// for each TrackRole, 1 + slot of its track in embeddedTracks_, or 0 if it is not there;
+      /// empty if no track is embedded in embeddedTracks_
+      std::vector<uint8_t> embeddedTrackSlots_;
+
+      // the per-role vectors below are only filled in files written before embeddedTracks_
+
       /// best muon track
       bool embeddedMuonBestTrack_;
       std::vector<reco::Track> muonBestTrack_;
@@ -283,6 +318,19 @@ namespace pat {
 
       unsigned int  numberOfValidHits_;/// globalTrack->numberOfValidHits()
 
+      // ---- track-quality summary ----
+      pat::MuonTrackSummary trackSummary_;
+
+    private:
+
+      /// embedded track of a role, from embeddedTracks_ or else from the per-role vector
+      reco::TrackRef embeddedTrack(TrackRole role, const std::vector<reco::Track> & roleTracks) const;
+      /// embed the track of a role, in the slot of an identical embedded track if any;
+      /// false if the source track is null
+      bool embedRoleTrack(TrackRole role, const reco::TrackRef & source);
+      /// true if two tracks are copies of the same fit
+      static bool sameTrack(const reco::Track & a, const reco::Track & b);
+
   };
 
 
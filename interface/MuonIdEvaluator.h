@@ -0,0 +1,45 @@
+#ifndef DataFormats_PatCandidates_MuonIdEvaluator_h
+#define DataFormats_PatCandidates_MuonIdEvaluator_h
+
+/**
+  \class    pat::MuonIdEvaluator MuonIdEvaluator.h "DataFormats/PatCandidates/interface/MuonIdEvaluator.h"
+  \brief    Applies the loose, medium, tight and soft muon identifications to a whole muon collection
+
+   The variables of the track summaries of all the muons (see pat::Muon::trackSummary), with the
+   impact parameters computed with respect to the given vertex, are gathered into one array per
+   variable, then the cuts of pat::MuonTrackSummary are applied in a single loop without branches
+   over these arrays, which the compiler can vectorize. The arrays are kept between calls, so
+   evaluating the muons of each event does not allocate memory once they are large enough.
+
+   Muons without a stored track summary get one computed from their tracks, which must then be
+   available.
+*/
+
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include <vector>
+
+namespace pat {
+
+  class MuonIdEvaluator {
+    public:
+      /// bits of the result of each muon
+      enum Selection { Loose = 1, Medium = 2, Tight = 4, Soft = 8 };
+
+      MuonIdEvaluator() {}
+
+      /// apply the identifications to all the muons; ids[i] has the Selection bits of the
+      /// identifications passed by the muon i
+      void evaluate(const std::vector<Muon> & muons, const reco::Vertex & vertex, std::vector<unsigned char> & ids) ;
+
+    private:
+      /// per-variable arrays, kept between calls
+      std::vector<uint8_t> flags_;
+      std::vector<float>   innerNormChi2_, innerValidFraction_, innerAbsDxy_, innerAbsDz_;
+      std::vector<float>   globalNormChi2_, bestAbsDxy_, bestAbsDz_;
+      std::vector<float>   chi2LocalPosition_, trkKink_, segmentCompatibility_;
+      std::vector<int>     innerLayers_, innerPixelLayers_, innerPixelHits_, globalMuonHits_, matchedStations_;
+  };
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef DataFormats_PatCandidates_MuonTrackSummary_h
+#define DataFormats_PatCandidates_MuonTrackSummary_h
+
+/**
+  \class    pat::MuonTrackSummary MuonTrackSummary.h "DataFormats/PatCandidates/interface/MuonTrackSummary.h"
+  \brief    Fixed-size summary of the track quality of a pat::Muon, enough for the muon identification
+
+   The summary keeps, for the inner, global and best tracks of the muon, the normalized chi2, the
+   pt uncertainty, the numbers of valid hits and of layers with measurements, and the reference
+   point and momentum from which the impact parameters with respect to any vertex are computed,
+   together with the muon-level quantities used by the loose, medium, tight and soft muon
+   identifications. It is filled at PAT production (pat::Muon::fillTrackSummary), so that these
+   identifications are evaluated without dereferencing the tracks; the tracks need to be embedded
+   or kept only for the analyses which use more than the summary.
+
+   The cuts of the identifications are the static ...Cuts functions, written without branches so
+   that pat::MuonIdEvaluator can apply them in vectorizable loops over a whole collection.
+*/
+
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/Math/interface/Point3D.h"
+#include <boost/cstdint.hpp>
+#include <cmath>
+
+namespace reco { class Muon; }
+
+namespace pat {
+
+  struct MuonTrackQuality {
+    MuonTrackQuality() :
+      normChi2(0), ptError(0), validFraction(0), vx(0), vy(0), vz(0), px(0), py(0), pz(0),
+      validHits(0), validPixelHits(0), validMuonHits(0), trackerLayers(0), pixelLayers(0), present(false) {}
+
+    /// fill from a track
+    void fill(const reco::Track & track) ;
+
+    /// transverse impact parameter with respect to a point, as reco::TrackBase::dxy
+    float dxy(const math::XYZPoint & point) const {
+      return (-(vx - point.x()) * py + (vy - point.y()) * px) / ptOrOne();
+    }
+    /// longitudinal impact parameter with respect to a point, as reco::TrackBase::dz
+    float dz(const math::XYZPoint & point) const {
+      float pt = ptOrOne();
+      return (vz - point.z()) - ((vx - point.x()) * px + (vy - point.y()) * py) / pt * (pz / pt);
+    }
+
+    float   normChi2;       // chi2/ndof
+    float   ptError;
+    float   validFraction;  // valid tracker hits over valid and lost ones
+    float   vx, vy, vz;     // reference point
+    float   px, py, pz;     // momentum at the reference point
+    uint8_t validHits;
+    uint8_t validPixelHits;
+    uint8_t validMuonHits;
+    uint8_t trackerLayers;  // tracker layers with measurement
+    uint8_t pixelLayers;    // pixel layers with measurement
+    bool    present;        // false if the muon has no such track
+
+    private:
+      float ptOrOne() const { float pt = std::sqrt(px * px + py * py); return pt > 0 ? pt : 1.f; }
+  };
+
+  struct MuonTrackSummary {
+    /// muon-level flags
+    enum Flags { Filled = 1, PFMuon = 2, GlobalMuon = 4, TrackerMuon = 8, TMOneStationTight = 16 };
+
+    MuonTrackSummary() : segmentCompatibility(0), chi2LocalPosition(0), trkKink(0), matchedStations(0), flags(0) {}
+
+    /// fill from the muon and its inner, global and best tracks (which may be null)
+    void fill(const reco::Muon & muon, const reco::TrackRef & innerTrack, const reco::TrackRef & globalTrack, const reco::TrackRef & bestTrack) ;
+
+    /// true once filled
+    bool isFilled() const { return flags & Filled; }
+    bool hasFlag(Flags flag) const { return flags & flag; }
+
+    /// muon identifications, as in DataFormats/MuonReco/interface/MuonSelectors.h
+    bool isLooseMuon() const { return looseCuts(flags); }
+    bool isMediumMuon() const {
+      return mediumCuts(flags, inner.validFraction, global.normChi2, chi2LocalPosition, trkKink, segmentCompatibility);
+    }
+    bool isTightMuon(const math::XYZPoint & vertex) const {
+      return tightCuts(flags, global.normChi2, global.validMuonHits, matchedStations, inner.trackerLayers, inner.validPixelHits,
+                       std::abs(best.dxy(vertex)), std::abs(best.dz(vertex)));
+    }
+    bool isSoftMuon(const math::XYZPoint & vertex) const {
+      return softCuts(flags, inner.trackerLayers, inner.pixelLayers, inner.normChi2,
+                      std::abs(inner.dxy(vertex)), std::abs(inner.dz(vertex)));
+    }
+
+    /// cuts of the identifications, without branches
+    static unsigned char looseCuts(uint8_t flags) {
+      return ((flags & PFMuon) != 0) & ((flags & (GlobalMuon | TrackerMuon)) != 0);
+    }
+    static unsigned char mediumCuts(uint8_t flags, float innerValidFraction, float globalNormChi2,
+                                    float chi2LocalPosition, float trkKink, float segmentCompatibility) {
+      unsigned char goodGlobal = ((flags & GlobalMuon) != 0) & (globalNormChi2 < 3.f) & (chi2LocalPosition < 12.f) & (trkKink < 20.f);
+      float minCompatibility = goodGlobal ? 0.303f : 0.451f;
+      return looseCuts(flags) & (innerValidFraction > 0.8f) & (segmentCompatibility > minCompatibility);
+    }
+    static unsigned char tightCuts(uint8_t flags, float globalNormChi2, int globalMuonHits, int matchedStations,
+                                   int innerLayers, int innerPixelHits, float absBestDxy, float absBestDz) {
+      return ((flags & PFMuon) != 0) & ((flags & GlobalMuon) != 0) & (globalNormChi2 < 10.f) & (globalMuonHits > 0) &
+             (matchedStations > 1) & (innerLayers > 5) & (innerPixelHits > 0) & (absBestDxy < 0.2f) & (absBestDz < 0.5f);
+    }
+    static unsigned char softCuts(uint8_t flags, int innerLayers, int innerPixelLayers, float innerNormChi2,
+                                  float absInnerDxy, float absInnerDz) {
+      return ((flags & TMOneStationTight) != 0) & (innerLayers > 5) & (innerPixelLayers > 1) & (innerNormChi2 < 1.8f) &
+             (absInnerDxy < 3.f) & (absInnerDz < 30.f);
+    }
+
+    // ---- tracks ----
+    MuonTrackQuality inner;
+    MuonTrackQuality global;
+    MuonTrackQuality best;
+    // ---- muon ----
+    float   segmentCompatibility;
+    float   chi2LocalPosition;
+    float   trkKink;
+    uint8_t matchedStations;
+    uint8_t flags;
+  };
+
+}
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef DataFormats_PatCandidates_OverlapView_h
+#define DataFormats_PatCandidates_OverlapView_h
+
+/**
+  \class    pat::OverlapView OverlapView.h "DataFormats/PatCandidates/interface/OverlapView.h"
+  \brief    Lightweight read-only view over the overlapping items of a PAT object for one label
+
+   PATObject stores the overlaps of all labels in a flat array of keys with one offset per label,
+   and one CandidatePtr per distinct product; OverlapView gives access to the items of one label
+   as reco::CandidatePtr without copying them. It can also wrap a reco::CandidatePtrVector, which
+   is how overlaps read from files written with the old per-label storage are accessed.
+   The view refers to the storage of the PAT object, so it must not outlive it.
+*/
+
+#include "DataFormats/Candidate/interface/CandidateFwd.h"
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include <boost/cstdint.hpp>
+#include <iterator>
+#include <vector>
+
+namespace pat {
+
+  class OverlapView {
+    public:
+      typedef reco::CandidatePtr  value_type;
+      typedef size_t              size_type;
+
+      /// iterator over the overlapping items; dereferencing gives a reco::CandidatePtr by value.
+      /// It holds a copy of the view, so it stays valid when the view it comes from is gone
+      class const_iterator;
+
+      /// empty view
+      OverlapView() : legacy_(0), product_(0), keys_(0), items_(0), begin_(0), end_(0) {}
+      /// view over a CandidatePtrVector
+      explicit OverlapView(const reco::CandidatePtrVector & items) :
+        legacy_(&items), product_(0), keys_(0), items_(0), begin_(0), end_(items.size()) {}
+      /// view over the range [begin, end) of the flat key array, all keys referring to the same product;
+      /// if items is not null, it holds the full CandidatePtrs parallel to the keys and is used instead
+      OverlapView(const reco::CandidatePtr & product, const std::vector<uint32_t> & keys,
+                  const std::vector<reco::CandidatePtr> * items, size_t begin, size_t end) :
+        legacy_(0), product_(&product), keys_(&keys), items_(items), begin_(begin), end_(end) {}
+
+      /// number of overlapping items
+      size_t size()  const { return end_ - begin_; }
+      /// true if there are no overlapping items
+      bool   empty() const { return end_ == begin_; }
+      /// overlapping item by index (no range check)
+      reco::CandidatePtr operator[](size_t idx) const {
+        if (legacy_ != 0) return (*legacy_)[idx];
+        if (items_  != 0) return (*items_)[begin_ + idx];
+        return reco::CandidatePtr(product_->id(), (*keys_)[begin_ + idx], product_->productGetter());
+      }
+      const_iterator begin() const ;
+      const_iterator end()   const ;
+
+      /// copy the items into a CandidatePtrVector
+      reco::CandidatePtrVector ptrVector() const {
+        reco::CandidatePtrVector ret;
+        for (size_t i = 0, n = size(); i < n; ++i) ret.push_back((*this)[i]);
+        return ret;
+      }
+      /// conversion for code still expecting a CandidatePtrVector
+      operator reco::CandidatePtrVector() const { return ptrVector(); }
+
+      /// true if both views refer to the same items
+      bool sameItems(const OverlapView & other) const {
+        return legacy_ == other.legacy_ && keys_ == other.keys_ && items_ == other.items_ && begin_ == other.begin_;
+      }
+
+    private:
+      const reco::CandidatePtrVector         * legacy_;
+      const reco::CandidatePtr               * product_;
+      const std::vector<uint32_t>            * keys_;
+      const std::vector<reco::CandidatePtr>  * items_;
+      size_t begin_, end_;
+  };
+
+  class OverlapView::const_iterator {
+    public:
+      typedef std::forward_iterator_tag  iterator_category;
+      typedef reco::CandidatePtr         value_type;
+      typedef ptrdiff_t                  difference_type;
+      typedef const value_type *         pointer;
+      typedef value_type                 reference;
+      const_iterator() : idx_(0) {}
+      const_iterator(const OverlapView & view, size_t idx) : view_(view), idx_(idx) {}
+      reference operator*() const { return view_[idx_]; }
+      const_iterator & operator++() { ++idx_; return *this; }
+      const_iterator operator++(int) { const_iterator ret(*this); ++idx_; return ret; }
+      bool operator==(const const_iterator & other) const { return idx_ == other.idx_ && view_.sameItems(other.view_); }
+      bool operator!=(const const_iterator & other) const { return !(*this == other); }
+    private:
+      OverlapView view_;
+      size_t idx_;
+  };
+
+  inline OverlapView::const_iterator OverlapView::begin() const { return const_iterator(*this, 0); }
+  inline OverlapView::const_iterator OverlapView::end()   const { return const_iterator(*this, size()); }
+
+}
+
+#endif
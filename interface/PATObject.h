@@ -25,16 +25,22 @@
 #include <vector>
 #include <string>
 #include <iosfwd>
+#include <iterator>
 
 #include "DataFormats/PatCandidates/interface/TriggerObjectStandAlone.h"
 #include "DataFormats/PatCandidates/interface/LookupTableRecord.h"
 
 #include "DataFormats/HepMCCandidate/interface/GenParticle.h"
+#include "DataFormats/PatCandidates/interface/PackedGenParticle.h"
+#include "DataFormats/PatCandidates/interface/OverlapView.h"
 
 #include "DataFormats/PatCandidates/interface/UserData.h"
 #include "DataFormats/Common/interface/OwnVector.h"
 
 #include "DataFormats/PatCandidates/interface/CandKinResolution.h"
+#include "DataFormats/PatCandidates/interface/MemoryFootprint.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
 
 namespace pat {
 
@@ -212,8 +218,10 @@ namespace pat {
 
       /// Get generator level particle reference (might be a transient ref if the genParticle was embedded)
       /// If you stored multiple GenParticles, you can specify which one you want.
+      /// Note: this is a transient ref if the particles are embedded or taken from a shared pool
       reco::GenParticleRef      genParticleRef(size_t idx=0) const {
             if (idx >= genParticlesSize()) return reco::GenParticleRef();
+            if (!genParticlePool_.empty()) return reco::GenParticleRef(&unpackedGenParticlePool_(), idx);
             return genParticleEmbedded_.empty() ? genParticleRef_[idx] : reco::GenParticleRef(&genParticleEmbedded_, idx);
       }
       /// Get a generator level particle reference with a given pdg id and status
@@ -231,18 +239,62 @@ namespace pat {
 
       /// Get generator level particle, as C++ pointer (might be 0 if the ref was null)
       /// If you stored multiple GenParticles, you can specify which one you want.
+      /// For embedded particles this is a plain index into the embedded vector, no Ref is built.
+      /// Particles taken from a shared pool are unpacked into reco::GenParticles on first access.
       const reco::GenParticle * genParticle(size_t idx=0)    const {
-            reco::GenParticleRef ref = genParticleRef(idx);
+            if (idx >= genParticlesSize()) return 0;
+            if (!genParticlePool_.empty()) return &unpackedGenParticlePool_()[idx];
+            if (!genParticleEmbedded_.empty()) return &genParticleEmbedded_[idx];
+            const reco::GenParticleRef & ref = genParticleRef_[idx];
             return ref.isNonnull() ? ref.get() : 0;
       }
-      /// Number of generator level particles stored as ref or embedded
+      /// Number of generator level particles stored as ref, embedded or taken from a shared pool
       size_t genParticlesSize() const {
+            if (!genParticlePool_.empty()) return genParticlePool_.size();
             return genParticleEmbedded_.empty() ? genParticleRef_.size() : genParticleEmbedded_.size();
       }
       /// Return the list of generator level particles.
       /// Note that the refs can be transient refs to embedded GenParticles
+      /// Note that this builds a new vector if the particles are embedded; to loop over the
+      /// particles without allocating use genParticle(idx) or genParticlesBegin()/genParticlesEnd()
       std::vector<reco::GenParticleRef> genParticleRefs() const ;
 
+      /// Iterator over the generator level particles, stored as refs or embedded.
+      /// Dereferencing gives a 'const reco::GenParticle *' (0 for a null ref); it never allocates.
+      class genParticle_iterator {
+        public:
+          typedef std::forward_iterator_tag  iterator_category;
+          typedef const reco::GenParticle *  value_type;
+          typedef ptrdiff_t                  difference_type;
+          typedef const value_type *         pointer;
+          typedef value_type                 reference;
+          genParticle_iterator() : obj_(0), idx_(0) {}
+          genParticle_iterator(const PATObject<ObjectType> * obj, size_t idx) : obj_(obj), idx_(idx) {}
+          reference operator*() const { return obj_->genParticle(idx_); }
+          reference operator->() const { return obj_->genParticle(idx_); }
+          genParticle_iterator & operator++() { ++idx_; return *this; }
+          genParticle_iterator operator++(int) { genParticle_iterator ret(*this); ++idx_; return ret; }
+          bool operator==(const genParticle_iterator & other) const { return idx_ == other.idx_ && obj_ == other.obj_; }
+          bool operator!=(const genParticle_iterator & other) const { return !(*this == other); }
+          /// index of the current particle, to be used with genParticleRef(idx) if a Ref is needed
+          size_t index() const { return idx_; }
+        private:
+          const PATObject<ObjectType> * obj_;
+          size_t idx_;
+      };
+      /// first generator level particle
+      genParticle_iterator genParticlesBegin() const { return genParticle_iterator(this, 0); }
+      /// one past the last generator level particle
+      genParticle_iterator genParticlesEnd()   const { return genParticle_iterator(this, genParticlesSize()); }
+
+      /// Fill the compact pdgId/status/charge summary of the generator level particles,
+      /// which genParticleById uses instead of dereferencing each particle.
+      /// It is filled automatically when the particles are embedded; for particles stored as
+      /// refs it is only filled on request, as it needs the referenced collection to be available.
+      void fillGenParticleSummary() ;
+      /// Returns true if the pdgId/status summary is available for all the generator level particles
+      bool hasGenParticleSummary() const { return !genParticleSummary_.empty() && genParticleSummary_.size() == 2*genParticlesSize(); }
+
       /// Set the generator level particle reference
       void setGenParticleRef(const reco::GenParticleRef &ref, bool embed=false) ;
       /// Add a generator level particle reference
@@ -254,11 +306,29 @@ namespace pat {
       /// Note that generator level particles can only be all embedded or all not embedded.
       void embedGenParticle() ;
 
+      /// Refer to generator level particles stored in an event-level pool of PackedGenParticles,
+      /// instead of holding refs to the full reco::GenParticle collection or embedded copies.
+      /// Any ref or embedded generator level particle is dropped.
+      void setPackedGenParticleRefs(const PackedGenParticleRefVector & refs) ;
+      /// Add a reference to a generator level particle stored in an event-level pool
+      /// Any ref or embedded generator level particle is dropped.
+      void addPackedGenParticleRef(const PackedGenParticleRef & ref) ;
+      /// References to the generator level particles in the event-level pool (empty if the pool is not used)
+      const PackedGenParticleRefVector & packedGenParticleRefs() const { return genParticlePool_; }
+      /// Get a generator level particle from the event-level pool, as C++ pointer (0 if not available)
+      const PackedGenParticle * packedGenParticle(size_t idx=0) const {
+            return idx < genParticlePool_.size() ? &*genParticlePool_[idx] : 0;
+      }
+
       /// Returns true if there was at least one overlap for this test label
       bool hasOverlaps(const std::string &label) const ;
       /// Return the list of overlaps for one label (can be empty)
       /// The original ordering of items is kept (usually it's by increasing deltaR from this item)
+      /// The PtrVectors of all the labels are made from the flat storage on the first call
       const reco::CandidatePtrVector & overlaps(const std::string &label) const ;
+      /// Return the list of overlaps for one label (can be empty), as a lightweight view on the flat storage
+      /// The original ordering of items is kept (usually it's by increasing deltaR from this item)
+      OverlapView overlapsView(const std::string &label) const ;
       /// Returns the labels of the overlap tests that found at least one overlap
       const std::vector<std::string> & overlapLabels() const { return overlapLabels_; }
       /// Sets the list of overlapping items for one label
@@ -400,6 +470,20 @@ namespace pat {
 
 
 
+      /// Memory used by this object, split by category of data members (see MemoryFootprint.h)
+      pat::MemoryFootprint memoryFootprint() const {
+            pat::MemoryFootprint ret;
+            fillMemoryFootprint(ret);
+            return ret;
+      }
+      /// Add the memory used by the data members to the report; each derived class adds its own members
+      /// after calling the method of its base class, and sets the object size to its own sizeof
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+
+      /// Round the floating point payloads to the number of mantissa bits of the policy (see FloatPrecisionPolicy.h),
+      /// before the object is written; each derived class rounds its own members after calling the method of its base class
+      virtual void reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) ;
+
     protected:
       // reference back to the original object
       edm::Ptr<reco::Candidate> refToOrig_;
@@ -416,11 +500,33 @@ namespace pat {
       std::vector<reco::GenParticleRef> genParticleRef_;
       /// vector to hold an embedded generator level particle
       std::vector<reco::GenParticle>    genParticleEmbedded_;
+      /// compact summary of the generator level particles, two integers per particle:
+      /// the pdgId, and (status << 2 | charge code) with charge code 0 = neutral, 1 = positive, 2 = negative;
+      /// the second integer is -1 for a null ref. Empty if not filled.
+      std::vector<int32_t>              genParticleSummary_;
+      /// references to generator level particles in an event-level pool
+      PackedGenParticleRefVector        genParticlePool_;
+      /// generator level particles from the pool, unpacked on first access (transient)
+      mutable std::vector<reco::GenParticle> genParticlePoolUnpacked_;
+      pat::CacheState                   isGenParticlePoolUnpacked_;
 
       /// Overlapping test labels (only if there are any overlaps)
       std::vector<std::string> overlapLabels_;
-      /// Overlapping items (sorted by distance)
+      /// Overlapping items (sorted by distance), one PtrVector per label.
+      /// Only filled for objects read from files written before the flat storage below; empty otherwise.
       std::vector<reco::CandidatePtrVector> overlapItems_;
+      /// Flat storage of the overlapping items: one CandidatePtr per distinct product, the product index
+      /// of each label, the offsets of each label in the key array (one more than the labels), and the keys
+      std::vector<reco::CandidatePtr> overlapProducts_;
+      std::vector<uint16_t>           overlapProductIndex_;
+      std::vector<uint32_t>           overlapOffsets_;
+      std::vector<uint32_t>           overlapKeys_;
+      /// The CandidatePtrs parallel to overlapKeys_, as given to setOverlaps (transient);
+      /// used in the job making the objects, where the Ptrs may not have a product getter yet
+      std::vector<reco::CandidatePtr> overlapItemsTransient_;
+      /// The PtrVectors returned by overlaps(), one per label, made from the flat storage on first access (transient)
+      mutable std::vector<reco::CandidatePtrVector> overlapItemsUnpacked_;
+      pat::CacheState                 isOverlapItemsUnpacked_;
 
       /// User data object
       std::vector<std::string>      userDataLabels_;
@@ -443,6 +549,14 @@ namespace pat {
 
     private:
       const pat::UserData *  userDataObject_(const std::string &key) const ;
+      /// generator level particles from the pool, unpacked into reco::GenParticles if not done yet
+      const std::vector<reco::GenParticle> & unpackedGenParticlePool_() const ;
+      /// check a generator level particle against the pdgId/status/autoCharge requests of genParticleById
+      bool genParticleMatches_(int gPdgId, int gStatus, int gCharge, int pdgId, int status, uint8_t autoCharge) const ;
+      /// view over the overlaps of the label with the given index
+      OverlapView overlapsView_(size_t idx) const ;
+      /// move overlaps read from old files into the flat storage, and make the transient Ptrs consistent with it
+      void prepareOverlapStorage_() ;
   };
 
 
@@ -652,15 +766,20 @@ namespace pat {
   void PATObject<ObjectType>::setGenParticleRef(const reco::GenParticleRef &ref, bool embed) {
           genParticleRef_ = std::vector<reco::GenParticleRef>(1,ref);
           genParticleEmbedded_.clear();
+          genParticleSummary_.clear();
           if (embed) embedGenParticle();
   }
 
   template <class ObjectType>
   void PATObject<ObjectType>::addGenParticleRef(const reco::GenParticleRef &ref) {
       if (!genParticleEmbedded_.empty()) { // we're embedding
-          if (ref.isNonnull()) genParticleEmbedded_.push_back(*ref);
+          if (ref.isNonnull()) {
+              genParticleEmbedded_.push_back(*ref);
+              if (!genParticleSummary_.empty()) fillGenParticleSummary();
+          }
       } else {
           genParticleRef_.push_back(ref);
+          genParticleSummary_.clear();
       }
   }
 
@@ -669,6 +788,7 @@ namespace pat {
       genParticleEmbedded_.clear();
       genParticleEmbedded_.push_back(particle);
       genParticleRef_.clear();
+      fillGenParticleSummary();
   }
 
   template <class ObjectType>
@@ -678,41 +798,118 @@ namespace pat {
           if (it->isNonnull()) genParticleEmbedded_.push_back(**it);
       }
       genParticleRef_.clear();
+      fillGenParticleSummary();
+  }
+
+  template <class ObjectType>
+  void PATObject<ObjectType>::fillGenParticleSummary() {
+      genParticleSummary_.clear();
+      genParticleSummary_.reserve(2*genParticlesSize());
+      for (size_t i = 0, n = genParticlesSize(); i < n; ++i) {
+          const reco::GenParticle * g = genParticle(i);
+          if (g == 0) {
+              genParticleSummary_.push_back(0);
+              genParticleSummary_.push_back(-1);
+          } else {
+              int32_t chargeCode = (g->charge() == 0 ? 0 : (g->charge() > 0 ? 1 : 2));
+              genParticleSummary_.push_back(g->pdgId());
+              genParticleSummary_.push_back((g->status() << 2) | chargeCode);
+          }
+      }
   }
 
   template <class ObjectType>
   std::vector<reco::GenParticleRef> PATObject<ObjectType>::genParticleRefs() const {
-        if (genParticleEmbedded_.empty()) return genParticleRef_;
-        std::vector<reco::GenParticleRef> ret(genParticleEmbedded_.size());
+        if (genParticleEmbedded_.empty() && genParticlePool_.empty()) return genParticleRef_;
+        std::vector<reco::GenParticleRef> ret(genParticlesSize());
         for (size_t i = 0, n = ret.size(); i < n; ++i) {
-            ret[i] = reco::GenParticleRef(&genParticleEmbedded_, i);
+            ret[i] = genParticleRef(i);
         }
         return ret;
   }
 
+  template <class ObjectType>
+  bool PATObject<ObjectType>::genParticleMatches_(int gPdgId, int gStatus, int gCharge, int pdgId, int status, uint8_t autoCharge) const {
+        if ((status != 0) && (gStatus != status)) return false;
+        if (pdgId == 0) {
+            return true;
+        } else if (!autoCharge) {
+            return (pdgId == gPdgId);
+        } else if (abs(pdgId) == abs(gPdgId)) {
+            // I want pdgId > 0 to match "correct charge" (for charged particles)
+            if (gCharge == 0) return true;
+            else if ((this->charge() == 0) && (pdgId == gPdgId)) return true;
+            else if (gCharge*this->charge()*pdgId > 0) return true;
+        }
+        return false;
+  }
+
   template <class ObjectType>
   reco::GenParticleRef PATObject<ObjectType>::genParticleById(int pdgId, int status, uint8_t autoCharge) const {
-        // get a vector, avoiding an unneeded copy if there is no embedding
-        const std::vector<reco::GenParticleRef> & vec = (genParticleEmbedded_.empty() ? genParticleRef_ : genParticleRefs());
-        for (std::vector<reco::GenParticleRef>::const_iterator ref = vec.begin(), end = vec.end(); ref != end; ++ref) {
-            if (ref->isNonnull()) {
-                const reco::GenParticle & g = **ref;
-                if ((status != 0) && (g.status() != status)) continue;
-                if (pdgId == 0) {
-                    return *ref;
-                } else if (!autoCharge) {
-                    if (pdgId == g.pdgId()) return *ref;
-                } else if (abs(pdgId) == abs(g.pdgId())) {
-                    // I want pdgId > 0 to match "correct charge" (for charged particles)
-                    if (g.charge() == 0) return *ref;
-                    else if ((this->charge() == 0) && (pdgId == g.pdgId())) return *ref;
-                    else if (g.charge()*this->charge()*pdgId > 0) return *ref;
-                }
+        if (!genParticlePool_.empty()) {
+            // scan the packed particles, unpacking them only to build the returned Ref
+            for (size_t i = 0, n = genParticlePool_.size(); i < n; ++i) {
+                const PackedGenParticle & g = *genParticlePool_[i];
+                if (genParticleMatches_(g.pdgId(), g.status(), g.charge(), pdgId, status, autoCharge)) return genParticleRef(i);
+            }
+        } else if (hasGenParticleSummary()) {
+            // scan the packed summary, building a Ref only for the matching particle
+            for (size_t i = 0, n = genParticlesSize(); i < n; ++i) {
+                int32_t gPdgId = genParticleSummary_[2*i], gWord = genParticleSummary_[2*i+1];
+                if (gWord < 0) continue; // null ref
+                int gCharge = ((gWord & 3) == 0 ? 0 : ((gWord & 3) == 1 ? 1 : -1));
+                if (genParticleMatches_(gPdgId, gWord >> 2, gCharge, pdgId, status, autoCharge)) return genParticleRef(i);
+            }
+        } else {
+            // no summary: loop over the particles by index, without building the vector of refs
+            for (size_t i = 0, n = genParticlesSize(); i < n; ++i) {
+                const reco::GenParticle * g = genParticle(i);
+                if (g == 0) continue;
+                if (genParticleMatches_(g->pdgId(), g->status(), g->charge(), pdgId, status, autoCharge)) return genParticleRef(i);
             }
         }
         return reco::GenParticleRef();
   }
 
+  template <class ObjectType>
+  void PATObject<ObjectType>::setPackedGenParticleRefs(const PackedGenParticleRefVector & refs) {
+      genParticleRef_.clear();
+      genParticleEmbedded_.clear();
+      genParticleSummary_.clear();
+      genParticlePoolUnpacked_.clear();
+      isGenParticlePoolUnpacked_.reset();
+      genParticlePool_ = refs;
+  }
+
+  template <class ObjectType>
+  void PATObject<ObjectType>::addPackedGenParticleRef(const PackedGenParticleRef & ref) {
+      if (genParticlePool_.empty()) {
+          genParticleRef_.clear();
+          genParticleEmbedded_.clear();
+          genParticleSummary_.clear();
+      }
+      genParticlePoolUnpacked_.clear();
+      isGenParticlePoolUnpacked_.reset();
+      genParticlePool_.push_back(ref);
+  }
+
+  template <class ObjectType>
+  const std::vector<reco::GenParticle> & PATObject<ObjectType>::unpackedGenParticlePool_() const {
+      if (isGenParticlePoolUnpacked_.isReady()) return genParticlePoolUnpacked_;
+      std::vector<reco::GenParticle> unpacked;
+      unpacked.reserve(genParticlePool_.size());
+      for (PackedGenParticleRefVector::const_iterator it = genParticlePool_.begin(), ed = genParticlePool_.end(); it != ed; ++it) {
+          unpacked.push_back((*it)->unpack());
+      }
+      if (isGenParticlePoolUnpacked_.tryStartFill()) {
+          genParticlePoolUnpacked_.swap(unpacked);
+          isGenParticlePoolUnpacked_.publish();
+      } else {
+          isGenParticlePoolUnpacked_.waitReady();
+      }
+      return genParticlePoolUnpacked_;
+  }
+
   template <class ObjectType>
   bool PATObject<ObjectType>::hasOverlaps(const std::string &label) const {
         return std::find(overlapLabels_.begin(), overlapLabels_.end(), label) != overlapLabels_.end();
@@ -723,22 +920,147 @@ namespace pat {
         static const reco::CandidatePtrVector EMPTY;
         std::vector<std::string>::const_iterator match = std::find(overlapLabels_.begin(), overlapLabels_.end(), label);
         if (match == overlapLabels_.end()) return EMPTY;
-        return overlapItems_[match - overlapLabels_.begin()];
+        size_t idx = match - overlapLabels_.begin();
+        if (!overlapItems_.empty()) return overlapItems_[idx];
+        if (!isOverlapItemsUnpacked_.isReady()) {
+            std::vector<reco::CandidatePtrVector> unpacked(overlapLabels_.size());
+            for (size_t i = 0, n = overlapLabels_.size(); i < n; ++i) {
+                OverlapView view = overlapsView_(i);
+                for (OverlapView::const_iterator it = view.begin(), ed = view.end(); it != ed; ++it) unpacked[i].push_back(*it);
+            }
+            if (isOverlapItemsUnpacked_.tryStartFill()) {
+                overlapItemsUnpacked_.swap(unpacked);
+                isOverlapItemsUnpacked_.publish();
+            } else {
+                isOverlapItemsUnpacked_.waitReady();
+            }
+        }
+        return overlapItemsUnpacked_[idx];
+  }
+
+  template <class ObjectType>
+  OverlapView PATObject<ObjectType>::overlapsView(const std::string &label) const {
+        std::vector<std::string>::const_iterator match = std::find(overlapLabels_.begin(), overlapLabels_.end(), label);
+        if (match == overlapLabels_.end()) return OverlapView();
+        return overlapsView_(match - overlapLabels_.begin());
+  }
+
+  template <class ObjectType>
+  OverlapView PATObject<ObjectType>::overlapsView_(size_t idx) const {
+        if (!overlapItems_.empty()) return OverlapView(overlapItems_[idx]);
+        return OverlapView(overlapProducts_[overlapProductIndex_[idx]], overlapKeys_,
+                           (overlapItemsTransient_.size() == overlapKeys_.size() ? &overlapItemsTransient_ : 0),
+                           overlapOffsets_[idx], overlapOffsets_[idx+1]);
   }
 
   template <class ObjectType>
   void PATObject<ObjectType>::setOverlaps(const std::string &label, const reco::CandidatePtrVector & overlaps) {
         if (!overlaps.empty()) {
+            prepareOverlapStorage_();
+            overlapItemsUnpacked_.clear();
+            isOverlapItemsUnpacked_.reset();
+            // find or add the product
+            size_t iprod = 0, nprod = overlapProducts_.size();
+            while (iprod < nprod && overlapProducts_[iprod].id() != overlaps.id()) ++iprod;
+            if (iprod == nprod) overlapProducts_.push_back(overlaps[0]);
+            // find or add the label; the items of an existing label are replaced in place
+            std::vector<uint32_t> keys(overlaps.size());
+            std::vector<reco::CandidatePtr> items(overlaps.size());
+            for (size_t i = 0, n = overlaps.size(); i < n; ++i) {
+                items[i] = overlaps[i];
+                keys[i]  = items[i].key();
+            }
             std::vector<std::string>::const_iterator match = std::find(overlapLabels_.begin(), overlapLabels_.end(), label);
             if (match == overlapLabels_.end()) {
                 overlapLabels_.push_back(label);
-                overlapItems_.push_back(overlaps);
+                overlapProductIndex_.push_back(iprod);
+                if (overlapOffsets_.empty()) overlapOffsets_.push_back(0);
+                overlapKeys_.insert(overlapKeys_.end(), keys.begin(), keys.end());
+                overlapItemsTransient_.insert(overlapItemsTransient_.end(), items.begin(), items.end());
+                overlapOffsets_.push_back(overlapKeys_.size());
             } else {
-                overlapItems_[match - overlapLabels_.begin()] = overlaps;
+                size_t idx = match - overlapLabels_.begin();
+                uint32_t first = overlapOffsets_[idx], last = overlapOffsets_[idx+1];
+                overlapKeys_.erase(overlapKeys_.begin() + first, overlapKeys_.begin() + last);
+                overlapKeys_.insert(overlapKeys_.begin() + first, keys.begin(), keys.end());
+                overlapItemsTransient_.erase(overlapItemsTransient_.begin() + first, overlapItemsTransient_.begin() + last);
+                overlapItemsTransient_.insert(overlapItemsTransient_.begin() + first, items.begin(), items.end());
+                for (size_t i = idx+1, n = overlapOffsets_.size(); i < n; ++i) {
+                    overlapOffsets_[i] = overlapOffsets_[i] - last + first + keys.size();
+                }
+                overlapProductIndex_[idx] = iprod;
+            }
+        }
+  }
+
+  template <class ObjectType>
+  void PATObject<ObjectType>::prepareOverlapStorage_() {
+        if (!overlapItems_.empty()) {
+            std::vector<std::string> labels;
+            labels.swap(overlapLabels_);
+            std::vector<reco::CandidatePtrVector> items;
+            items.swap(overlapItems_);
+            overlapProducts_.clear(); overlapProductIndex_.clear(); overlapOffsets_.clear();
+            overlapKeys_.clear(); overlapItemsTransient_.clear();
+            for (size_t i = 0, n = labels.size(); i < n; ++i) setOverlaps(labels[i], items[i]);
+        } else if (overlapItemsTransient_.size() != overlapKeys_.size()) {
+            // read from file: rebuild the Ptrs from the product table
+            overlapItemsTransient_.clear();
+            overlapItemsTransient_.reserve(overlapKeys_.size());
+            for (size_t i = 0, n = overlapLabels_.size(); i < n; ++i) {
+                const reco::CandidatePtr & product = overlapProducts_[overlapProductIndex_[i]];
+                for (uint32_t k = overlapOffsets_[i]; k < overlapOffsets_[i+1]; ++k) {
+                    overlapItemsTransient_.push_back(reco::CandidatePtr(product.id(), overlapKeys_[k], product.productGetter()));
+                }
             }
         }
   }
 
+  template <class ObjectType>
+  void PATObject<ObjectType>::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+        report.setObjectSize(sizeof(PATObject<ObjectType>));
+        report.addContainer("trigger matches", triggerObjectMatchesEmbedded_);
+        report.addContainer("efficiencies", efficiencyValues_);
+        report.addContainer("gen particles", genParticleRef_);
+        report.addContainer("gen particles", genParticleEmbedded_);
+        report.addContainer("gen particles", genParticleSummary_);
+        report.addItems("gen particles", genParticlePool_);
+        report.addContainer("gen particles", genParticlePoolUnpacked_);
+        report.addContainer("overlaps", overlapItems_);
+        for (std::vector<reco::CandidatePtrVector>::const_iterator it = overlapItems_.begin(), ed = overlapItems_.end(); it != ed; ++it) {
+            report.add("overlaps", 0, pat::memory::itemsSize(*it));
+        }
+        report.addContainer("overlaps", overlapProducts_);
+        report.addContainer("overlaps", overlapProductIndex_);
+        report.addContainer("overlaps", overlapOffsets_);
+        report.addContainer("overlaps", overlapKeys_);
+        report.addContainer("overlaps", overlapItemsTransient_);
+        report.addContainer("overlaps", overlapItemsUnpacked_);
+        for (std::vector<reco::CandidatePtrVector>::const_iterator it = overlapItemsUnpacked_.begin(), ed = overlapItemsUnpacked_.end(); it != ed; ++it) {
+            report.add("overlaps", 0, pat::memory::itemsSize(*it));
+        }
+        report.addItems("user data", userDataObjects_);
+        report.addContainer("user floats", userFloats_);
+        report.addContainer("user ints", userInts_);
+        report.addContainer("user cands", userCands_);
+        report.addContainer("kin resolutions", kinResolutions_);
+        report.addContainer("labels", efficiencyNames_);
+        report.addContainer("labels", overlapLabels_);
+        report.addContainer("labels", userDataLabels_);
+        report.addContainer("labels", userFloatLabels_);
+        report.addContainer("labels", userIntLabels_);
+        report.addContainer("labels", userCandLabels_);
+        report.addContainer("labels", kinResolutionLabels_);
+  }
+
+  template <class ObjectType>
+  void PATObject<ObjectType>::reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) {
+        policy.reduce(pat::FloatPrecisionPolicy::UserFloats, userFloats_);
+        for (std::vector<pat::CandKinResolution>::iterator it = kinResolutions_.begin(), ed = kinResolutions_.end(); it != ed; ++it) {
+            it->reduceFloatPrecision(policy);
+        }
+  }
+
   template <class ObjectType>
   const pat::UserData * PATObject<ObjectType>::userDataObject_( const std::string & key ) const
   {
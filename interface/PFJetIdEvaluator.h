@@ -0,0 +1,62 @@
+#ifndef DataFormats_PatCandidates_PFJetIdEvaluator_h
+#define DataFormats_PatCandidates_PFJetIdEvaluator_h
+
+/**
+  \class    pat::PFJetIdEvaluator PFJetIdEvaluator.h "DataFormats/PatCandidates/interface/PFJetIdEvaluator.h"
+  \brief    Applies a working point of the PF jet identification to a whole jet collection
+
+   The energy fractions and multiplicities of all the jets (see pat::Jet::energyFractions) are
+   gathered into one array per variable, then the cuts are applied in a single loop without
+   branches over these arrays, which the compiler can vectorize. The arrays are kept between
+   calls, so evaluating the jets of each event does not allocate memory once they are large enough.
+
+   The cuts are the ones of the PF jet identification: upper cuts on the neutral hadron and
+   neutral electromagnetic fractions and a minimum number of constituents for all jets, plus
+   cuts on the charged hadron fraction, charged multiplicity and charged electromagnetic fraction
+   for the jets inside the tracker acceptance.
+*/
+
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include <vector>
+
+namespace pat {
+
+  class PFJetIdEvaluator {
+    public:
+      /// cuts of a working point
+      struct WorkingPoint {
+        WorkingPoint() :
+          maxNeutralHadronFraction(0.99), maxNeutralEmFraction(0.99), minConstituents(2),
+          maxChargedAbsEta(2.4), minChargedHadronFraction(0.), minChargedMultiplicity(1), maxChargedEmFraction(0.99) {}
+        float maxNeutralHadronFraction;  // NHF <  cut
+        float maxNeutralEmFraction;      // NEF <  cut
+        int   minConstituents;           // nConstituents >= cut
+        float maxChargedAbsEta;          // the following cuts apply for |eta| < cut
+        float minChargedHadronFraction;  // CHF >  cut
+        int   minChargedMultiplicity;    // CHM >= cut
+        float maxChargedEmFraction;      // CEF <  cut
+      };
+      /// loose working point
+      static WorkingPoint loose() ;
+      /// tight working point
+      static WorkingPoint tight() ;
+
+      explicit PFJetIdEvaluator(const WorkingPoint & workingPoint = loose()) : workingPoint_(workingPoint) {}
+
+      /// working point applied
+      const WorkingPoint & workingPoint() const { return workingPoint_; }
+
+      /// apply the working point to all the jets, which must be PF jets; pass[i] is 1
+      /// if the jet i passes, 0 otherwise
+      void evaluate(const std::vector<Jet> & jets, std::vector<unsigned char> & pass) ;
+
+    private:
+      WorkingPoint workingPoint_;
+      /// per-variable arrays, kept between calls
+      std::vector<float> neutralHadron_, neutralEm_, chargedHadron_, chargedEm_, absEta_;
+      std::vector<int>   nConstituents_, chargedMultiplicity_;
+  };
+
+}
+
+#endif
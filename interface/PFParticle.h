@@ -47,6 +47,9 @@ namespace pat {
 
       /// required reimplementation of the Candidate's clone method
       virtual PFParticle * clone() const { return new PFParticle(*this); }
+
+      /// Memory report of the PATObject part, with the size of the pat::PFParticle
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
     
   };
   
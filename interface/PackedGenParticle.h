@@ -0,0 +1,71 @@
+#ifndef DataFormats_PatCandidates_PackedGenParticle_h
+#define DataFormats_PatCandidates_PackedGenParticle_h
+
+/**
+  \class    pat::PackedGenParticle PackedGenParticle.h "DataFormats/PatCandidates/interface/PackedGenParticle.h"
+  \brief    Compact copy of a reco::GenParticle, to be stored once per event in a pool shared by the PAT objects
+
+   PackedGenParticle keeps only the information used by the generator level matching of the PAT
+   objects: the four-momentum (pt, eta, phi, mass in single precision), the pdgId, the status, the
+   charge and the index of the first mother inside the same pool (-1 if it is not stored in the pool).
+   The PAT objects refer to the pool through a PackedGenParticleRefVector, so a particle matched to
+   several objects or collections is written only once per event.
+*/
+
+#include "DataFormats/HepMCCandidate/interface/GenParticle.h"
+#include "DataFormats/Common/interface/Ref.h"
+#include "DataFormats/Common/interface/RefVector.h"
+#include "DataFormats/Common/interface/RefProd.h"
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace pat {
+
+  class PackedGenParticle {
+    public:
+      /// default constructor
+      PackedGenParticle() :
+        pt_(0), eta_(0), phi_(0), mass_(0), pdgId_(0), status_(0), charge_(0), motherIndex_(-1) {}
+      /// constructor from a reco::GenParticle; motherIndex is the position of its mother in the pool, if any
+      PackedGenParticle(const reco::GenParticle & particle, int motherIndex=-1) :
+        pt_(particle.pt()), eta_(particle.eta()), phi_(particle.phi()), mass_(particle.mass()),
+        pdgId_(particle.pdgId()), status_(particle.status()), charge_(particle.charge()), motherIndex_(motherIndex) {}
+
+      /// four-momentum in polar coordinates
+      reco::Candidate::PolarLorentzVector polarP4() const { return reco::Candidate::PolarLorentzVector(pt_, eta_, phi_, mass_); }
+      /// four-momentum in cartesian coordinates
+      reco::Candidate::LorentzVector p4() const { return reco::Candidate::LorentzVector(polarP4()); }
+      float pt()   const { return pt_; }
+      float eta()  const { return eta_; }
+      float phi()  const { return phi_; }
+      float mass() const { return mass_; }
+      int pdgId()  const { return pdgId_; }
+      int status() const { return status_; }
+      int charge() const { return charge_; }
+      /// index of the first mother in the same pool, -1 if the mother is not stored
+      int motherIndex() const { return motherIndex_; }
+      bool hasMother() const { return motherIndex_ >= 0; }
+      /// set the index of the first mother in the same pool
+      void setMotherIndex(int motherIndex) { motherIndex_ = motherIndex; }
+
+      /// unpack into a reco::GenParticle; the vertex is set to the origin and there are no mother/daughter links
+      reco::GenParticle unpack() const {
+        return reco::GenParticle(charge_, p4(), reco::Candidate::Point(0,0,0), pdgId_, status_, true);
+      }
+
+    private:
+      float   pt_, eta_, phi_, mass_;
+      int32_t pdgId_;
+      int16_t status_;
+      int8_t  charge_;
+      int32_t motherIndex_;
+  };
+
+  typedef std::vector<PackedGenParticle>                PackedGenParticleCollection;
+  typedef edm::Ref<PackedGenParticleCollection>         PackedGenParticleRef;
+  typedef edm::RefVector<PackedGenParticleCollection>   PackedGenParticleRefVector;
+  typedef edm::RefProd<PackedGenParticleCollection>     PackedGenParticleRefProd;
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef DataFormats_PatCandidates_PackedPFCandidate_h
+#define DataFormats_PatCandidates_PackedPFCandidate_h
+
+/**
+  \class    pat::PackedPFCandidate PackedPFCandidate.h "DataFormats/PatCandidates/interface/PackedPFCandidate.h"
+  \brief    Slimmed copy of a reco::PFCandidate, to be stored once per event in a pool shared by the jets
+
+   PackedPFCandidate keeps only the four-momentum (pt, eta, phi, mass in single precision), the
+   charge and the particle type of a reco::PFCandidate. The jets refer to the pool through a
+   PackedPFCandidateRefVector, so a candidate which is a constituent of jets of several collections
+   (cleaned, uncleaned, groomed, subjets) is written only once per event, instead of one full
+   reco::PFCandidate per jet.
+*/
+
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/Common/interface/Ref.h"
+#include "DataFormats/Common/interface/RefVector.h"
+#include "DataFormats/Common/interface/RefProd.h"
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace pat {
+
+  class PackedPFCandidate {
+    public:
+      /// default constructor
+      PackedPFCandidate() :
+        pt_(0), eta_(0), phi_(0), mass_(0), charge_(0), particleType_(reco::PFCandidate::X) {}
+      /// constructor from a reco::PFCandidate
+      explicit PackedPFCandidate(const reco::PFCandidate & candidate) :
+        pt_(candidate.pt()), eta_(candidate.eta()), phi_(candidate.phi()), mass_(candidate.mass()),
+        charge_(candidate.charge()), particleType_(candidate.particleId()) {}
+
+      /// four-momentum in polar coordinates
+      reco::Candidate::PolarLorentzVector polarP4() const { return reco::Candidate::PolarLorentzVector(pt_, eta_, phi_, mass_); }
+      /// four-momentum in cartesian coordinates
+      reco::Candidate::LorentzVector p4() const { return reco::Candidate::LorentzVector(polarP4()); }
+      float pt()   const { return pt_; }
+      float eta()  const { return eta_; }
+      float phi()  const { return phi_; }
+      float mass() const { return mass_; }
+      int charge() const { return charge_; }
+      /// particle type, as in reco::PFCandidate
+      reco::PFCandidate::ParticleType particleId() const { return reco::PFCandidate::ParticleType(particleType_); }
+      /// pdgId, as set by reco::PFCandidate from the particle type and the charge
+      int pdgId() const {
+        switch (particleType_) {
+          case reco::PFCandidate::h:         return  211*charge_;
+          case reco::PFCandidate::e:         return  -11*charge_;
+          case reco::PFCandidate::mu:        return  -13*charge_;
+          case reco::PFCandidate::gamma:     return   22;
+          case reco::PFCandidate::h0:        return  130;
+          case reco::PFCandidate::h_HF:      return    1;
+          case reco::PFCandidate::egamma_HF: return    2;
+          default:                           return    0;
+        }
+      }
+
+      /// unpack into a reco::PFCandidate; only the four-momentum, the charge and the type are set
+      reco::PFCandidate unpack() const {
+        return reco::PFCandidate(charge_, p4(), particleId());
+      }
+
+    private:
+      float  pt_, eta_, phi_, mass_;
+      int8_t charge_;
+      int8_t particleType_;
+  };
+
+  typedef std::vector<PackedPFCandidate>                PackedPFCandidateCollection;
+  typedef edm::Ref<PackedPFCandidateCollection>         PackedPFCandidateRef;
+  typedef edm::RefVector<PackedPFCandidateCollection>   PackedPFCandidateRefVector;
+  typedef edm::RefProd<PackedPFCandidateCollection>     PackedPFCandidateRefProd;
+
+}
+
+#endif
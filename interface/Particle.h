@@ -45,6 +45,9 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual Particle * clone() const { return new Particle(*this); }
 
+      /// Memory report: pat::Particle has no data members of its own, so only the object size changes
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+
   };
 
 
@@ -24,6 +24,8 @@
 #include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"
 #include "DataFormats/EgammaReco/interface/SuperCluster.h"
 #include "DataFormats/PatCandidates/interface/Isolation.h"
+#include "DataFormats/PatCandidates/interface/IdStore.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
 
 
 // Define typedefs for convenience
@@ -63,6 +65,9 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual Photon * clone() const { return new Photon(*this); }
 
+      /// Add the memory used by the embedded supercluster, photon IDs and isolation to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+
       // ---- methods for content embedding ----
       /// override the superCluster method from CaloJet, to access the internal storage of the supercluster
       reco::SuperClusterRef superCluster() const;
@@ -79,14 +84,44 @@ namespace pat {
       /// Returns a specific photon ID associated to the pat::Photon given its name.
       /// Note: an exception is thrown if the specified ID is not available
       Bool_t photonID(const std::string & name) const;
+      /// Returns the photon ID of the handle; the slot of the ID is looked up once per schema.
+      /// Note: an exception is thrown if the specified ID is not available
+      Bool_t photonID(DiscriminatorHandle & handle) const;
+      /// Sets value to the photon ID with the given name; returns false, without throwing, if it is not available
+      bool photonID(const std::string & name, Bool_t & value) const;
+      /// Sets value to the photon ID of the handle; returns false, without throwing, if it is not available
+      bool photonID(DiscriminatorHandle & handle, Bool_t & value) const;
       /// Returns true if a specific ID is available in this pat::Photon
       bool isPhotonIDAvailable(const std::string & name) const;
+      bool isPhotonIDAvailable(DiscriminatorHandle & handle) const { Bool_t value; return photonID(handle, value); }
+      /// Returns true if the photon passes all the working points of the mask: a single test of the packed
+      /// booleans when they are all in the schema, otherwise each ID must be available and true
+      bool passPhotonIDs(IdMask & mask) const { return IdPairs<Bool_t>::passes(photonIDStore_, photonIDs_, mask); }
+      /// Sets pass[i] to 1 for the photons passing all the working points of the mask, 0 otherwise
+      static void passPhotonIDs(const std::vector<Photon> & photons, IdMask & mask, std::vector<unsigned char> & pass) {
+        IdStore::passAll(photons, &Photon::photonIDStore, &Photon::passPhotonIDs, mask, pass);
+      }
       /// Returns all the Photon IDs in the form of <name,value> pairs
       /// The 'default' ID is the first in the list
-      const std::vector<IdPair> &  photonIDs() const { return photonIDs_; }
+      const std::vector<IdPair> &  photonIDs() const { return photonIDPairs_.all(photonIDStore_, photonIDs_); }
+      /// Returns the photon IDs stored by slot of the schema of the collection
+      const pat::IdStore & photonIDStore() const { return photonIDStore_; }
       /// Store multiple photon ID values, discarding existing ones
       /// The first one in the list becomes the 'default' photon id 
-      void setPhotonIDs(const std::vector<IdPair> & ids) { photonIDs_ = ids; }
+      /// With a schema, all the names must be in the schema; schemaContent is the schema object,
+      /// needed in the module producing it, where the RefProd can not be dereferenced yet
+      void setPhotonIDs(const std::vector<IdPair> & ids, const IdSchema * schemaContent = 0) {
+        photonIDPairs_.set(photonIDStore_, photonIDs_, ids, schemaContent, "pat::Photon");
+      }
+      /// Set the ID schema of the collection; the IDs already stored are moved to their slots, looked up
+      /// in schemaContent if given (the schema object, which is not kept), otherwise through the RefProd
+      void setPhotonIDSchema(const IdSchemaRefProd & schema, const IdSchema * schemaContent = 0) {
+        photonIDPairs_.setSchema(photonIDStore_, photonIDs_, schema, schemaContent, "pat::Photon");
+      }
+      /// Set the photon ID in a slot of the schema (schemaContent: as for setPhotonIDs)
+      void setPhotonID(unsigned int slot, Bool_t value, const IdSchema * schemaContent = 0) {
+        photonIDPairs_.set(photonIDStore_, slot, value, schemaContent);
+      }
 
 
       // ---- methods for photon isolation ----
@@ -193,6 +228,10 @@ namespace pat {
       std::vector<reco::SuperCluster> superCluster_;
       // ---- photon ID's holder ----
       std::vector<IdPair> photonIDs_;
+      // by slot of the schema of the collection (used instead of photonIDs_ when it has a schema)
+      pat::IdStore photonIDStore_;
+      // access by name to photonIDStore_ or photonIDs_ (transient)
+      pat::IdPairs<Bool_t> photonIDPairs_;
       // ---- Isolation and IsoDeposit related datamebers ----
       typedef std::vector<std::pair<IsolationKeys, pat::IsoDeposit> > IsoDepositPairs;
       IsoDepositPairs    isoDeposits_;
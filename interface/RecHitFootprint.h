@@ -0,0 +1,78 @@
+#ifndef DataFormats_PatCandidates_RecHitFootprint_h
+#define DataFormats_PatCandidates_RecHitFootprint_h
+
+/**
+  \class    pat::RecHitFootprint RecHitFootprint.h "DataFormats/PatCandidates/interface/RecHitFootprint.h"
+  \brief    Ecal rechits inside a window around an electron or photon, as a structure of flat arrays
+
+   Instead of a copy of the whole rechit collection, only the rechits inside a window are kept
+   (e.g. 5x5 crystals around the seed, or the crystals of the supercluster plus a halo around
+   each of them). The detector id, energy, time, flags and flag bits of the rechits are stored in
+   one array each, sorted by detector id, so a rechit is found by binary search.
+
+   The window is a list of detector ids, built with addSquareWindow and addSuperClusterWindow;
+   unpack() gives back the rechits as an EcalRecHitCollection for the cluster shape tools.
+*/
+
+#include "DataFormats/EcalRecHit/interface/EcalRecHitCollections.h"
+#include "DataFormats/DetId/interface/DetId.h"
+#include "DataFormats/EgammaReco/interface/SuperCluster.h"
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace pat {
+
+  class RecHitFootprint {
+    public:
+      RecHitFootprint() {}
+
+      /// keep the rechits of the collection which are inside the window; the window may contain
+      /// duplicates and ids which have no rechit
+      void fill(const EcalRecHitCollection & recHits, const std::vector<DetId> & window) ;
+      /// remove all the rechits
+      void clear() ;
+
+      /// number of rechits
+      size_t size() const { return detIds_.size(); }
+      bool empty() const { return detIds_.empty(); }
+      /// index of the rechit with the given detector id, -1 if it is not in the footprint
+      int index(DetId id) const ;
+      /// true if the rechit with the given detector id is in the footprint
+      bool contains(DetId id) const { return index(id) >= 0; }
+
+      /// values of the rechit i
+      DetId    detId(size_t i)    const { return DetId(detIds_[i]); }
+      float    energy(size_t i)   const { return energies_[i]; }
+      float    time(size_t i)     const { return times_[i]; }
+      uint32_t flags(size_t i)    const { return flags_[i]; }
+      uint32_t flagBits(size_t i) const { return flagBits_[i]; }
+      /// energy of the rechit with the given detector id, 0 if it is not in the footprint
+      float energy(DetId id) const { int i = index(id); return i >= 0 ? energies_[i] : 0.f; }
+      /// the rechit i, rebuilt from its stored values
+      EcalRecHit recHit(size_t i) const ;
+      /// all the rechits, as an EcalRecHitCollection
+      void unpack(EcalRecHitCollection & recHits) const ;
+
+      /// flat arrays, sorted by detector id
+      const std::vector<uint32_t> & detIds()   const { return detIds_; }
+      const std::vector<float>    & energies() const { return energies_; }
+      const std::vector<float>    & times()    const { return times_; }
+
+      /// add to the window the ids of the crystals within halfWidth crystals in eta/phi (barrel)
+      /// or x/y (endcaps) of the given one, e.g. halfWidth = 2 for 5x5
+      static void addSquareWindow(DetId center, int halfWidth, std::vector<DetId> & window) ;
+      /// add to the window the crystals of the supercluster and, if haloHalfWidth > 0, the crystals
+      /// within haloHalfWidth of each of them
+      static void addSuperClusterWindow(const reco::SuperCluster & superCluster, int haloHalfWidth, std::vector<DetId> & window) ;
+
+    private:
+      std::vector<uint32_t> detIds_;
+      std::vector<float>    energies_;
+      std::vector<float>    times_;
+      std::vector<uint32_t> flags_;
+      std::vector<uint32_t> flagBits_;
+  };
+
+}
+
+#endif
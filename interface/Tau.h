@@ -24,6 +24,9 @@
 #include "DataFormats/TauReco/interface/BaseTau.h"
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/PatCandidates/interface/Lepton.h"
+#include "DataFormats/PatCandidates/interface/CacheState.h"
+#include "DataFormats/PatCandidates/interface/IdStore.h"
+#include "DataFormats/PatCandidates/interface/ConstituentView.h"
 #include "DataFormats/JetReco/interface/GenJetCollection.h"
 #include "DataFormats/Candidate/interface/Candidate.h"
 
@@ -37,6 +40,8 @@ namespace pat {
   typedef std::vector<Tau>              TauCollection; 
   typedef edm::Ref<TauCollection>       TauRef; 
   typedef edm::RefVector<TauCollection> TauRefVector; 
+  typedef ConstituentView<reco::Track>        TauTrackView;
+  typedef ConstituentView<reco::PFCandidate>  TauPFCandidateView;
 }
 
 namespace reco {
@@ -71,6 +76,9 @@ namespace pat {
       /// required reimplementation of the Candidate's clone method
       virtual Tau * clone() const { return new Tau(*this); }
 
+      /// Add the memory used by the embedded tau tracks and PF candidates, tau IDs and corrections to the report
+      virtual void fillMemoryFootprint(pat::MemoryFootprint & report) const ;
+
       // ---- methods for content embedding ----
       /// override the reco::BaseTau::isolationTracks method, to access the internal storage of the isolation tracks
       const reco::TrackRefVector & isolationTracks() const;
@@ -78,6 +86,9 @@ namespace pat {
       reco::TrackRef leadTrack() const;
       /// override the reco::BaseTau::signalTracks method, to access the internal storage of the signal tracks
       const reco::TrackRefVector & signalTracks() const;	
+      /// views over the isolation and signal tracks, embedded or not, which neither fill nor cache any RefVector
+      TauTrackView isolationTracksView() const;
+      TauTrackView signalTracksView() const;
       /// method to store the isolation tracks internally
       void embedIsolationTracks();
       /// method to store the leading track internally
@@ -94,6 +105,10 @@ namespace pat {
       /// method to store the signal candidates internally
       void embedSignalPFCands();
       /// method to store the signal charged hadrons candidates internally
+      /// The charged hadron, neutral hadron and gamma candidates are subsets of the signal (isolation)
+      /// candidates: they are stored as indices into the embedded signal (isolation) candidates, so that
+      /// each candidate is stored only once. If those are not embedded, the candidates of the embedded
+      /// subsets are stored in their place as internal storage, and signalPFCands() is not affected
       void embedSignalPFChargedHadrCands();
       /// method to store the signal neutral hadrons candidates internally
       void embedSignalPFNeutralHadrCands();
@@ -101,7 +116,7 @@ namespace pat {
       void embedSignalPFGammaCands();
       /// method to store the isolation candidates internally
       void embedIsolationPFCands();
-      /// method to store the isolation charged hadrons candidates internally
+      /// method to store the isolation charged hadrons candidates internally (see embedSignalPFChargedHadrCands)
       void embedIsolationPFChargedHadrCands();
       /// method to store the isolation neutral hadrons candidates internally
       void embedIsolationPFNeutralHadrCands();
@@ -197,6 +212,17 @@ namespace pat {
       /// Method copied from reco::PFTau. 
       /// Throws an exception if this pat::Tau was not made from a reco::PFTau
       const std::vector<reco::RecoTauPiZero> & isolationPiZeroCandidates() const;
+      /// Views over the signal and isolation PF candidates, embedded or not, which neither fill nor
+      /// cache any RefVector, so they are cheap and safe to use from several threads reading the same tau.
+      /// Throw an exception if this pat::Tau was not made from a reco::PFTau and the candidates are not embedded
+      TauPFCandidateView signalPFCandsView() const;
+      TauPFCandidateView signalPFChargedHadrCandsView() const;
+      TauPFCandidateView signalPFNeutrHadrCandsView() const;
+      TauPFCandidateView signalPFGammaCandsView() const;
+      TauPFCandidateView isolationPFCandsView() const;
+      TauPFCandidateView isolationPFChargedHadrCandsView() const;
+      TauPFCandidateView isolationPFNeutrHadrCandsView() const;
+      TauPFCandidateView isolationPFGammaCandsView() const;
       /// Method copied from reco::PFTau. 
       /// Throws an exception if this pat::Tau was not made from a reco::PFTau
       float isolationPFChargedHadrCandsPtSum() const { return pfSpecific().isolationPFChargedHadrCandsPtSum_; }
@@ -263,14 +289,44 @@ namespace pat {
       /// Note: an exception is thrown if the specified ID is not available
       float tauID(const std::string & name) const;
       float tauID(const char* name ) const {return tauID( std::string(name) );}
+      /// Returns the tau ID of the handle; the slot of the ID is looked up once per schema.
+      /// Note: an exception is thrown if the specified ID is not available
+      float tauID(DiscriminatorHandle & handle) const;
+      /// Sets value to the tau ID with the given name; returns false, without throwing, if it is not available
+      bool tauID(const std::string & name, float & value) const;
+      /// Sets value to the tau ID of the handle; returns false, without throwing, if it is not available
+      bool tauID(DiscriminatorHandle & handle, float & value) const;
       /// Returns true if a specific ID is available in this pat::Tau
       bool isTauIDAvailable(const std::string & name) const;
+      bool isTauIDAvailable(DiscriminatorHandle & handle) const { float value; return tauID(handle, value); }
+      /// Returns true if the tau passes all the working points of the mask: a single test of the packed
+      /// booleans when they are all in the schema, otherwise each ID must be available and true
+      bool passTauIDs(IdMask & mask) const { return IdPairs<float>::passes(tauIDStore_, tauIDs_, mask); }
+      /// Sets pass[i] to 1 for the taus passing all the working points of the mask, 0 otherwise
+      static void passTauIDs(const std::vector<Tau> & taus, IdMask & mask, std::vector<unsigned char> & pass) {
+        IdStore::passAll(taus, &Tau::tauIDStore, &Tau::passTauIDs, mask, pass);
+      }
       /// Returns all the tau IDs in the form of <name,value> pairs
       /// The 'default' ID is the first in the list
-      const std::vector<IdPair> &  tauIDs() const { return tauIDs_; }
+      const std::vector<IdPair> &  tauIDs() const { return tauIDPairs_.all(tauIDStore_, tauIDs_); }
+      /// Returns the tau IDs stored by slot of the schema of the collection
+      const pat::IdStore & tauIDStore() const { return tauIDStore_; }
       /// Store multiple tau ID values, discarding existing ones
       /// The first one in the list becomes the 'default' tau id 
-      void setTauIDs(const std::vector<IdPair> & ids) { tauIDs_ = ids; }
+      /// With a schema, all the names must be in the schema; schemaContent is the schema object,
+      /// needed in the module producing it, where the RefProd can not be dereferenced yet
+      void setTauIDs(const std::vector<IdPair> & ids, const IdSchema * schemaContent = 0) {
+        tauIDPairs_.set(tauIDStore_, tauIDs_, ids, schemaContent, "pat::Tau");
+      }
+      /// Set the ID schema of the collection; the IDs already stored are moved to their slots, looked up
+      /// in schemaContent if given (the schema object, which is not kept), otherwise through the RefProd
+      void setTauIDSchema(const IdSchemaRefProd & schema, const IdSchema * schemaContent = 0) {
+        tauIDPairs_.setSchema(tauIDStore_, tauIDs_, schema, schemaContent, "pat::Tau");
+      }
+      /// Set the tau ID in a slot of the schema (schemaContent: as for setTauIDs)
+      void setTauID(unsigned int slot, float value, const IdSchema * schemaContent = 0) {
+        tauIDPairs_.set(tauIDStore_, slot, value, schemaContent);
+      }
 
       /// pipe operator (introduced to use pat::Tau with PFTopProjectors)
       friend std::ostream& reco::operator<<(std::ostream& out, const Tau& obj);
@@ -340,13 +396,13 @@ namespace pat {
       bool embeddedIsolationTracks_;
       std::vector<reco::Track> isolationTracks_;
       mutable reco::TrackRefVector isolationTracksTransientRefVector_;
-      mutable bool       isolationTracksTransientRefVectorFixed_;
+      pat::CacheState isolationTracksTransientRefVectorFixed_;
       bool embeddedLeadTrack_;
       std::vector<reco::Track> leadTrack_;
       bool embeddedSignalTracks_;
       std::vector<reco::Track> signalTracks_;
       mutable reco::TrackRefVector signalTracksTransientRefVector_;
-      mutable bool       signalTracksTransientRefVectorFixed_;
+      pat::CacheState signalTracksTransientRefVectorFixed_;
       // specific for PFTau
       std::vector<reco::PFCandidate> leadPFCand_;
       bool embeddedLeadPFCand_;
@@ -355,44 +411,54 @@ namespace pat {
       std::vector<reco::PFCandidate> leadPFNeutralCand_;
       bool embeddedLeadPFNeutralCand_;
 
-      std::vector<reco::PFCandidate> signalPFCands_;
+      std::vector<reco::PFCandidate> signalPFCands_; // or only the candidates of the embedded subsets, if not embedded
       bool embeddedSignalPFCands_;
       mutable reco::PFCandidateRefVector signalPFCandsTransientRefVector_;
-      mutable bool signalPFCandsRefVectorFixed_;
-      std::vector<reco::PFCandidate> signalPFChargedHadrCands_;
+      pat::CacheState signalPFCandsRefVectorFixed_;
+      std::vector<reco::PFCandidate> signalPFChargedHadrCands_; // copies, in files written before the indices
+      std::vector<uint16_t> signalPFChargedHadrCandIndices_; // in signalPFCands_
       bool embeddedSignalPFChargedHadrCands_;
       mutable reco::PFCandidateRefVector signalPFChargedHadrCandsTransientRefVector_;
-      mutable bool signalPFChargedHadrCandsRefVectorFixed_;
-      std::vector<reco::PFCandidate> signalPFNeutralHadrCands_;
+      pat::CacheState signalPFChargedHadrCandsRefVectorFixed_;
+      std::vector<reco::PFCandidate> signalPFNeutralHadrCands_; // copies, in files written before the indices
+      std::vector<uint16_t> signalPFNeutralHadrCandIndices_; // in signalPFCands_
       bool embeddedSignalPFNeutralHadrCands_;
       mutable reco::PFCandidateRefVector signalPFNeutralHadrCandsTransientRefVector_;
-      mutable bool signalPFNeutralHadrCandsRefVectorFixed_;
-      std::vector<reco::PFCandidate> signalPFGammaCands_;
+      pat::CacheState signalPFNeutralHadrCandsRefVectorFixed_;
+      std::vector<reco::PFCandidate> signalPFGammaCands_; // copies, in files written before the indices
+      std::vector<uint16_t> signalPFGammaCandIndices_; // in signalPFCands_
       bool embeddedSignalPFGammaCands_;
       mutable reco::PFCandidateRefVector signalPFGammaCandsTransientRefVector_;
-      mutable bool signalPFGammaCandsRefVectorFixed_;
-      std::vector<reco::PFCandidate> isolationPFCands_;
+      pat::CacheState signalPFGammaCandsRefVectorFixed_;
+      std::vector<reco::PFCandidate> isolationPFCands_; // or only the candidates of the embedded subsets, if not embedded
       bool embeddedIsolationPFCands_;
       mutable reco::PFCandidateRefVector isolationPFCandsTransientRefVector_;
-      mutable bool isolationPFCandsRefVectorFixed_;
-      std::vector<reco::PFCandidate> isolationPFChargedHadrCands_;
+      pat::CacheState isolationPFCandsRefVectorFixed_;
+      std::vector<reco::PFCandidate> isolationPFChargedHadrCands_; // copies, in files written before the indices
+      std::vector<uint16_t> isolationPFChargedHadrCandIndices_; // in isolationPFCands_
       bool embeddedIsolationPFChargedHadrCands_;
       mutable reco::PFCandidateRefVector isolationPFChargedHadrCandsTransientRefVector_;
-      mutable bool isolationPFChargedHadrCandsRefVectorFixed_;
-      std::vector<reco::PFCandidate> isolationPFNeutralHadrCands_;
+      pat::CacheState isolationPFChargedHadrCandsRefVectorFixed_;
+      std::vector<reco::PFCandidate> isolationPFNeutralHadrCands_; // copies, in files written before the indices
+      std::vector<uint16_t> isolationPFNeutralHadrCandIndices_; // in isolationPFCands_
       bool embeddedIsolationPFNeutralHadrCands_;
       mutable reco::PFCandidateRefVector isolationPFNeutralHadrCandsTransientRefVector_;
-      mutable bool isolationPFNeutralHadrCandsRefVectorFixed_;
-      std::vector<reco::PFCandidate> isolationPFGammaCands_;
+      pat::CacheState isolationPFNeutralHadrCandsRefVectorFixed_;
+      std::vector<reco::PFCandidate> isolationPFGammaCands_; // copies, in files written before the indices
+      std::vector<uint16_t> isolationPFGammaCandIndices_; // in isolationPFCands_
       bool embeddedIsolationPFGammaCands_;
       mutable reco::PFCandidateRefVector isolationPFGammaCandsTransientRefVector_;
-      mutable bool isolationPFGammaCandsRefVectorFixed_;
+      pat::CacheState isolationPFGammaCandsRefVectorFixed_;
 
       // ---- matched GenJet holder ----
       std::vector<reco::GenJet> genJet_;
 
       // ---- tau ID's holder ----
       std::vector<IdPair> tauIDs_;
+      // by slot of the schema of the collection (used instead of tauIDs_ when it has a schema)
+      pat::IdStore tauIDStore_;
+      // access by name to tauIDStore_ or tauIDs_ (transient)
+      pat::IdPairs<float> tauIDPairs_;
 
       // ---- CaloTau specific variables  ----
       /// holder for CaloTau info, or empty vector if PFTau
@@ -23,3 +23,10 @@ CompositeCandidate::CompositeCandidate(const reco::CompositeCandidate & aComposi
 /// destructor
 CompositeCandidate::~CompositeCandidate() {
 }
+
+
+/// memory footprint
+void CompositeCandidate::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  PATObject<reco::CompositeCandidate>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(CompositeCandidate));
+}
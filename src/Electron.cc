@@ -295,9 +295,48 @@ void Electron::embedRecHits(const EcalRecHitCollection * rechits) {
   if (rechits!=0) {
     recHits_ = *rechits;
     embeddedRecHits_ = true;
+    recHitFootprint_.clear();
+    isRecHitFootprintUnpacked_.reset();
   }
 }
 
+// method to store internally the RecHits inside a window only
+void Electron::embedRecHitFootprint(const EcalRecHitCollection * rechits, const std::vector<DetId> & window) {
+  if (rechits!=0) {
+    recHitFootprint_.fill(*rechits, window);
+    recHits_ = EcalRecHitCollection();
+    embeddedRecHits_ = true;
+    isRecHitFootprintUnpacked_.reset();
+  }
+}
+
+// method to store internally the RecHits around the seed and the supercluster
+void Electron::embedRecHitFootprint(const EcalRecHitCollection * rechits, int seedHalfWidth, int superClusterHalo) {
+  std::vector<DetId> window;
+  reco::SuperClusterRef sc = superCluster();
+  if (sc.isNonnull()) {
+    if (sc->seed().isNonnull()) pat::RecHitFootprint::addSquareWindow(sc->seed()->seed(), seedHalfWidth, window);
+    if (superClusterHalo >= 0) pat::RecHitFootprint::addSuperClusterWindow(*sc, superClusterHalo, window);
+  }
+  embedRecHitFootprint(rechits, window);
+}
+
+// embedded RecHits, unpacking the footprint once if that is what was embedded
+const EcalRecHitCollection * Electron::recHits() const {
+  if (recHitFootprint_.empty()) return &recHits_;
+  if (!isRecHitFootprintUnpacked_.isReady()) {
+    EcalRecHitCollection unpacked;
+    recHitFootprint_.unpack(unpacked);
+    if (isRecHitFootprintUnpacked_.tryStartFill()) {
+      recHitFootprintUnpacked_.swap(unpacked);
+      isRecHitFootprintUnpacked_.publish();
+    } else {
+      isRecHitFootprintUnpacked_.waitReady();
+    }
+  }
+  return &recHitFootprintUnpacked_;
+}
+
 /// Returns a specific electron ID associated to the pat::Electron given its name
 /// For cut-based IDs, the value map has the following meaning:
 /// 0: fails,
@@ -313,25 +352,30 @@ void Electron::embedRecHits(const EcalRecHitCollection * rechits) {
 /// https://twiki.cern.ch/twiki/bin/view/CMS/SWGuideCategoryBasedElectronID
 /// Note: an exception is thrown if the specified ID is not available
 float Electron::electronID(const std::string& name) const {
-    for (std::vector<IdPair>::const_iterator it = electronIDs_.begin(), ed = electronIDs_.end(); it != ed; ++it) {
-        if (it->first == name) return it->second;
-    }
-    cms::Exception ex("Key not found");
-    ex << "pat::Electron: the ID " << name << " can't be found in this pat::Electron.\n";
-    ex << "The available IDs are: ";
-    for (std::vector<IdPair>::const_iterator it = electronIDs_.begin(), ed = electronIDs_.end(); it != ed; ++it) {
-        ex << "'" << it->first << "' ";
-    }
-    ex << ".\n";
-    throw ex;
+    return electronIDPairs_.get(electronIDStore_, electronIDs_, name, "pat::Electron");
+}
+
+/// Returns the electron ID of the handle, or throws if it is not available
+float Electron::electronID(DiscriminatorHandle & handle) const {
+    float value;
+    if (electronID(handle, value)) return value;
+    return electronID(handle.label());
+}
+
+/// Gets a specific electron ID given its name, without throwing if it is not available
+bool Electron::electronID(const std::string& name, float & value) const {
+    return IdPairs<float>::get(electronIDStore_, electronIDs_, name, value);
+}
+
+/// Gets the electron ID of the handle, without throwing if it is not available
+bool Electron::electronID(DiscriminatorHandle & handle, float & value) const {
+    return IdPairs<float>::get(electronIDStore_, electronIDs_, handle, value);
 }
 
 /// Checks if a specific electron ID is associated to the pat::Electron.
 bool Electron::isElectronIDAvailable(const std::string& name) const {
-    for (std::vector<IdPair>::const_iterator it = electronIDs_.begin(), ed = electronIDs_.end(); it != ed; ++it) {
-        if (it->first == name) return true;
-    }
-    return false;
+    float value;
+    return electronID(name, value);
 }
 
 
@@ -439,3 +483,36 @@ void Electron::setMvaVariables( double r9, double sigmaIphiIphi, double sigmaIet
   sigmaIetaIphi_ = sigmaIetaIphi;
   ip3d_ = ip3d;
 } 
+
+void Electron::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  Lepton<reco::GsfElectron>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(Electron));
+  report.addContainer("embedded core", gsfElectronCore_);
+  report.addContainer("embedded tracks", gsfTrack_);
+  report.addContainer("embedded tracks", track_);
+  report.addContainer("embedded clusters", superCluster_);
+  report.addContainer("embedded clusters", basicClusters_);
+  report.addContainer("embedded clusters", preshowerClusters_);
+  report.addContainer("embedded clusters", pflowSuperCluster_);
+  report.addContainer("embedded clusters", pflowBasicClusters_);
+  report.addContainer("embedded clusters", pflowPreshowerClusters_);
+  report.addContainer("embedded clusters", seedCluster_);
+  report.addItems("embedded rechits", recHits_);
+  report.add("embedded rechits", 0, recHitFootprint_.size()*(3*sizeof(uint32_t) + 2*sizeof(float)));
+  report.addItems("embedded rechits", recHitFootprintUnpacked_);
+  report.addContainer("IDs", electronIDs_);
+  report.addContainer("IDs", electronIDStore_.floats());
+  report.addContainer("PF candidates", pfCandidate_);
+  report.addContainer("impact parameters", cachedIP_);
+  report.addContainer("impact parameters", ip_);
+  report.addContainer("impact parameters", eip_);
+}
+
+/// float precision
+void Electron::reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) {
+  Lepton<reco::GsfElectron>::reduceFloatPrecision(policy);
+  dB_ = policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, dB_);
+  edB_ = policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, edB_);
+  policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, ip_);
+  policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, eip_);
+}
@@ -0,0 +1,111 @@
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
+
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+
+using namespace pat;
+
+
+const unsigned int FloatPrecisionPolicy::FullPrecision;
+
+namespace {
+  const char * const memberNames[FloatPrecisionPolicy::NumberOfMembers] = {
+    "userFloats", "bDiscriminators", "jecFactors", "isolations", "kinResolutions", "impactParameters"
+  };
+}
+
+void
+FloatPrecisionPolicy::setMantissaBits(Member member, unsigned int bits)
+{
+  if(member >= NumberOfMembers){
+    throw cms::Exception("InvalidRequest") << "FloatPrecisionPolicy: unknown member " << int(member) << ".\n";
+  }
+  if(bits < 1 || bits > FullPrecision){
+    throw cms::Exception("InvalidRequest") << "FloatPrecisionPolicy: the number of mantissa bits of '" << memberName(member)
+                                           << "' must be between 1 and " << FullPrecision << ", not " << bits << ".\n";
+  }
+  mantissaBits_.resize(NumberOfMembers, FullPrecision);
+  mantissaBits_[member] = bits;
+}
+
+void
+FloatPrecisionPolicy::setMantissaBits(const std::string & name, unsigned int bits)
+{
+  Member m;
+  if(!member(name, m)){
+    cms::Exception ex("InvalidRequest");
+    ex << "FloatPrecisionPolicy: unknown member '" << name << "'. Available members are:";
+    for(int i=0; i<NumberOfMembers; ++i) ex << " '" << memberNames[i] << "'";
+    ex << ".\n";
+    throw ex;
+  }
+  setMantissaBits(m, bits);
+}
+
+bool
+FloatPrecisionPolicy::isLossless() const
+{
+  for(std::vector<unsigned char>::const_iterator it = mantissaBits_.begin(); it != mantissaBits_.end(); ++it){
+    if(*it < FullPrecision) return false;
+  }
+  return true;
+}
+
+const char *
+FloatPrecisionPolicy::memberName(Member member)
+{
+  return member < NumberOfMembers ? memberNames[member] : "unknown";
+}
+
+bool
+FloatPrecisionPolicy::member(const std::string & name, Member & member)
+{
+  for(int i=0; i<NumberOfMembers; ++i){
+    if(name == memberNames[i]){
+      member = Member(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+float
+FloatPrecisionPolicy::reduceMantissa(float value, unsigned int bits)
+{
+  if(bits >= FullPrecision) return value;
+  uint32_t word;
+  std::memcpy(&word, &value, sizeof(word));
+  // leave infinities and NaNs alone
+  if((word & 0x7f800000) == 0x7f800000) return value;
+  const unsigned int shift = FullPrecision - bits;
+  // round to nearest; a carry out of the mantissa correctly increments the exponent
+  const uint32_t sign = word & 0x80000000;
+  word += (uint32_t(1) << (shift - 1));
+  // values rounding beyond the largest finite float become the largest finite value with these bits
+  if((word & 0x7f800000) == 0x7f800000) word = sign | 0x7f7fffff;
+  word &= ~((uint32_t(1) << shift) - 1);
+  std::memcpy(&value, &word, sizeof(value));
+  return value;
+}
+
+void
+FloatPrecisionPolicy::reduce(Member member, std::vector<float> & values) const
+{
+  const unsigned int bits = mantissaBits(member);
+  if(bits >= FullPrecision) return;
+  for(std::vector<float>::iterator it = values.begin(); it != values.end(); ++it){
+    *it = reduceMantissa(*it, bits);
+  }
+}
+
+void
+FloatPrecisionPolicy::reduce(Member member, std::vector<double> & values) const
+{
+  const unsigned int bits = mantissaBits(member);
+  if(bits >= FullPrecision) return;
+  for(std::vector<double>::iterator it = values.begin(); it != values.end(); ++it){
+    *it = reduceMantissa(float(*it), bits);
+  }
+}
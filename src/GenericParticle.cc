@@ -190,3 +190,19 @@ bool GenericParticle::overlap( const reco::Candidate &cand ) const {
    }
    return false;
 }
+
+void GenericParticle::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+   PATObject<reco::RecoCandidate>::fillMemoryFootprint(report);
+   report.setObjectSize(sizeof(GenericParticle));
+   report.addContainer("embedded tracks", track_);
+   report.addContainer("embedded tracks", standaloneTrack_);
+   report.addContainer("embedded tracks", combinedTrack_);
+   report.addContainer("embedded tracks", gsfTrack_);
+   report.addContainer("embedded tracks", tracks_);
+   report.addItems("embedded tracks", trackRefs_);
+   report.addItems("embedded clusters", caloTower_);
+   report.addContainer("embedded clusters", superCluster_);
+   report.addContainer("isolation", isoDeposits_);
+   report.addContainer("isolation", isolations_);
+   report.addContainer("vertex associations", vtxAss_);
+}
@@ -0,0 +1,151 @@
+#include "DataFormats/PatCandidates/interface/IdStore.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <limits>
+
+
+using namespace pat;
+
+
+const unsigned int IdSchema::MaxBooleans;
+
+unsigned int
+IdSchema::add(const std::string & name, Kind kind)
+{
+  int existing = slots_.index(name);
+  if (existing >= 0) return existing;
+  unsigned int slot = slots_.add(name);
+  if (kind == Boolean && nBooleans_ < MaxBooleans) {
+    kinds_.push_back(Boolean);
+    positions_.push_back(nBooleans_++);
+  } else {
+    kinds_.push_back(Float);
+    positions_.push_back(nFloats_++);
+  }
+  return slot;
+}
+
+bool
+IdSchema::isBoolean(const std::vector<float> & values)
+{
+  for (std::vector<float>::const_iterator it = values.begin(); it != values.end(); ++it) {
+    if (*it != 0.f && *it != 1.f) return false;
+  }
+  return true;
+}
+
+
+void
+IdStore::setSchema(const IdSchemaRefProd & schema)
+{
+  schema_ = schema;
+  clear();
+}
+
+void
+IdStore::clear()
+{
+  floats_.clear();
+  booleans_ = 0;
+  booleansSet_ = 0;
+}
+
+void
+IdStore::set(unsigned int slot, float value, const IdSchema * schemaContent)
+{
+  const IdSchema * ids = (schemaContent != 0 ? schemaContent : schema());
+  if (ids == 0 || slot >= ids->size()) {
+    throw cms::Exception("InvalidRequest") << "pat::IdStore: slot " << slot << " is not in the ID schema of this object.\n";
+  }
+  unsigned int position = ids->position(slot);
+  if (ids->kind(slot) == IdSchema::Boolean) {
+    uint64_t bit = uint64_t(1) << position;
+    if (value > 0.5) booleans_ |= bit; else booleans_ &= ~bit;
+    booleansSet_ |= bit;
+  } else {
+    if (position >= floats_.size()) floats_.resize(ids->nFloats(), std::numeric_limits<float>::quiet_NaN());
+    floats_[position] = value;
+  }
+}
+
+bool
+IdStore::isSet(unsigned int slot) const
+{
+  const IdSchema * ids = schema();
+  if (ids == 0 || slot >= ids->size()) return false;
+  unsigned int position = ids->position(slot);
+  if (ids->kind(slot) == IdSchema::Boolean) return (booleansSet_ >> position) & 1;
+  return position < floats_.size() && floats_[position] == floats_[position];
+}
+
+bool
+IdStore::get(unsigned int slot, float & value) const
+{
+  if (!isSet(slot)) return false;
+  const IdSchema * ids = schema();
+  unsigned int position = ids->position(slot);
+  if (ids->kind(slot) == IdSchema::Boolean) value = ((booleans_ >> position) & 1) ? 1.f : 0.f;
+  else value = floats_[position];
+  return true;
+}
+
+bool
+IdStore::get(DiscriminatorHandle & handle, float & value) const
+{
+  const IdSchema * ids = schema();
+  if (ids == 0) return false;
+  int slot = ids->slot(handle);
+  return slot >= 0 && get(slot, value);
+}
+
+bool
+IdStore::get(const std::string & name, float & value) const
+{
+  const IdSchema * ids = schema();
+  if (ids == 0) return false;
+  int slot = ids->index(name);
+  return slot >= 0 && get(slot, value);
+}
+
+void
+IdStore::fillPairs(std::vector<std::pair<std::string, float> > & pairs) const
+{
+  pairs.clear();
+  const IdSchema * ids = schema();
+  if (ids == 0) return;
+  pairs.reserve(ids->size());
+  float value;
+  for (unsigned int slot = 0, n = ids->size(); slot < n; ++slot) {
+    if (get(slot, value)) pairs.push_back(std::make_pair(ids->name(slot), value));
+  }
+}
+
+void
+IdStore::passes(const uint64_t * words, const uint64_t * masks, size_t n, unsigned char * pass)
+{
+  for (size_t i = 0; i < n; ++i) {
+    pass[i] = ((words[i] & masks[i]) == masks[i]);
+  }
+}
+
+
+IdMask::IdMask(const std::vector<std::string> & labels) :
+  labels_(labels)
+{
+  for (std::vector<std::string>::const_iterator it = labels_.begin(); it != labels_.end(); ++it) {
+    handles_.push_back(DiscriminatorHandle(*it));
+  }
+}
+
+bool
+IdMask::bits(const IdSchema * schema, uint64_t & bits)
+{
+  bits = 0;
+  if (schema == 0) return false;
+  for (std::vector<DiscriminatorHandle>::iterator it = handles_.begin(); it != handles_.end(); ++it) {
+    int slot = schema->slot(*it);
+    if (slot < 0 || schema->kind(slot) != IdSchema::Boolean) return false;
+    bits |= uint64_t(1) << schema->position(slot);
+  }
+  return true;
+}
@@ -0,0 +1,35 @@
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "DataFormats/PatCandidates/interface/JecHandle.h"
+
+
+using namespace pat;
+
+
+JecHandle::JecHandle(const std::string& level, const std::string& flavor, const std::string& set) :
+  level_(level), set_(set), flavor_(JetCorrFactors::NONE), resolved_(false), nSets_(0), nLevels_(0), setIndex_(0), levelIndex_(0)
+{
+  if(!JetCorrFactors::jecFlavor(flavor, flavor_)){
+    throw cms::Exception("InvalidRequest") << "You ask for a flavor, which does not exist. Available flavors are: \n"
+					   << "'uds', 'charm', 'bottom', 'gluon', 'none', (not case sensitive).   \n";
+  }
+}
+
+bool
+JecHandle::resolve(const std::vector<JetCorrFactors>& jec)
+{
+  resolved_ = false;
+  // same choice of the set as the jecFactor methods of the pat::Jet taking strings
+  for(unsigned int idx=0; idx<jec.size(); ++idx){
+    if(set_.empty() || jec[idx].isJecSet(set_)){
+      int level = jec[idx].jecLevel(level_);
+      if(level<0) return false;
+      nSets_ = jec.size();
+      nLevels_ = jec[idx].numberOfCorrectionLevels();
+      setIndex_ = idx;
+      levelIndex_ = level;
+      resolved_ = true;
+      return true;
+    }
+  }
+  return false;
+}
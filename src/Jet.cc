@@ -6,30 +6,32 @@
 #include "DataFormats/RecoCandidate/interface/RecoCaloTowerCandidate.h"
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "DataFormats/Math/interface/deltaR.h"
+
+#include <algorithm>
+#include <limits>
 
 using namespace pat;
 
 /// default constructor
 Jet::Jet() :
   PATObject<reco::Jet>(reco::Jet()),
-  embeddedCaloTowers_(false),
-  embeddedPFCandidates_(false),
+  caloTowersStorage_(NotEmbedded),
+  pfCandidatesStorage_(NotEmbedded),
   partonFlavour_(0),
-  jetCharge_(0.),
-  isCaloTowerCached_(false),
-  isPFCandidateCached_(false)
+  tagInfosStorage_(NotEmbedded),
+  jetCharge_(0.)
 {
 }
 
 /// constructor from a reco::Jet
 Jet::Jet(const reco::Jet & aJet) :
   PATObject<reco::Jet>(aJet),
-  embeddedCaloTowers_(false),
-  embeddedPFCandidates_(false),
+  caloTowersStorage_(NotEmbedded),
+  pfCandidatesStorage_(NotEmbedded),
   partonFlavour_(0),
-  jetCharge_(0.0),
-  isCaloTowerCached_(false),
-  isPFCandidateCached_(false)
+  tagInfosStorage_(NotEmbedded),
+  jetCharge_(0.0)
 {
   tryImportSpecific(aJet);
 }
@@ -37,12 +39,11 @@ Jet::Jet(const reco::Jet & aJet) :
 /// constructor from ref to reco::Jet
 Jet::Jet(const edm::Ptr<reco::Jet> & aJetRef) :
   PATObject<reco::Jet>(aJetRef),
-  embeddedCaloTowers_(false),
-  embeddedPFCandidates_(false),
+  caloTowersStorage_(NotEmbedded),
+  pfCandidatesStorage_(NotEmbedded),
   partonFlavour_(0),
-  jetCharge_(0.0),
-  isCaloTowerCached_(false),
-  isPFCandidateCached_(false)
+  tagInfosStorage_(NotEmbedded),
+  jetCharge_(0.0)
 {
   tryImportSpecific(*aJetRef);
 }
@@ -50,12 +51,11 @@ Jet::Jet(const edm::Ptr<reco::Jet> & aJetRef) :
 /// constructor from ref to reco::Jet
 Jet::Jet(const edm::RefToBase<reco::Jet> & aJetRef) :
   PATObject<reco::Jet>(aJetRef),
-  embeddedCaloTowers_(false),
-  embeddedPFCandidates_(false),
+  caloTowersStorage_(NotEmbedded),
+  pfCandidatesStorage_(NotEmbedded),
   partonFlavour_(0),
-  jetCharge_(0.0),
-  isCaloTowerCached_(false),
-  isPFCandidateCached_(false)
+  tagInfosStorage_(NotEmbedded),
+  jetCharge_(0.0)
 {
   tryImportSpecific(*aJetRef);
 }
@@ -109,84 +109,119 @@ Jet::~Jet() {
 /// ============= CaloJet methods ============
 
 CaloTowerPtr Jet::getCaloConstituent (unsigned fIndex) const {
-    if (embeddedCaloTowers_) {
+    switch ( caloTowersStorage() ) {
       // Refactorized PAT access
-      if ( caloTowersFwdPtr_.size() > 0 ) {
+      case FwdPtrEmbedded:
 	return (fIndex < caloTowersFwdPtr_.size() ?
 		caloTowersFwdPtr_[fIndex].ptr() : CaloTowerPtr());
-      }
       // Compatibility PAT access
-      else {
-	if ( caloTowers_.size() > 0 ) {
-	  return (fIndex < caloTowers_.size() ?
-		  CaloTowerPtr(&caloTowers_, fIndex) : CaloTowerPtr());
-
+      case CompatibilityEmbedded:
+	return (fIndex < caloTowers_.size() ?
+		CaloTowerPtr(&caloTowers_, fIndex) : CaloTowerPtr());
+      // Non-embedded access
+      default: {
+	Constituent dau = daughterPtr (fIndex);
+	const CaloTower* caloTower = dynamic_cast <const CaloTower*> (dau.get());
+	if (caloTower != 0) {
+	  return CaloTowerPtr(dau.id(), caloTower, dau.key() );
+	}
+	else {
+	  throw cms::Exception("Invalid Constituent") << "CaloJet constituent is not of CaloTower type";
 	}
       }
     }
-    // Non-embedded access
-    else {
-      Constituent dau = daughterPtr (fIndex);
-      const CaloTower* caloTower = dynamic_cast <const CaloTower*> (dau.get());
-      if (caloTower != 0) {
-	return CaloTowerPtr(dau.id(), caloTower, dau.key() );
-      }
-      else {
-	throw cms::Exception("Invalid Constituent") << "CaloJet constituent is not of CaloTower type";
-      }
-
-    }
-
-    return CaloTowerPtr ();
 }
 
 
 
 std::vector<CaloTowerPtr> const & Jet::getCaloConstituents () const {
-  if ( !isCaloTowerCached_ || caloTowers_.size() > 0 ) cacheCaloTowers();
+  if ( !isCaloTowerCached_.isReady() ) cacheCaloTowers();
   return caloTowersTemp_;
 }
 
+CaloConstituentView Jet::caloConstituents () const {
+  switch ( caloTowersStorage() ) {
+    case FwdPtrEmbedded:        return CaloConstituentView(caloTowersFwdPtr_);
+    case CompatibilityEmbedded: return CaloConstituentView(caloTowers_);
+    default:                    return CaloConstituentView(static_cast<const reco::Jet &>(*this));
+  }
+}
+
 
 /// ============= PFJet methods ============
 
 reco::PFCandidatePtr Jet::getPFConstituent (unsigned fIndex) const {
-    if (embeddedPFCandidates_) {
+    switch ( pfCandidatesStorage() ) {
       // Refactorized PAT access
-      if ( pfCandidatesFwdPtr_.size() > 0 ) {
+      case FwdPtrEmbedded:
 	return (fIndex < pfCandidatesFwdPtr_.size() ?
 		pfCandidatesFwdPtr_[fIndex].ptr() : reco::PFCandidatePtr());
-      }
+      // Event-level pool access
+      case PoolEmbedded:
+	return (fIndex < pfCandidatesPool_.size() ?
+		reco::PFCandidatePtr(&unpackedPFCandidatePool(), fIndex) : reco::PFCandidatePtr());
       // Compatibility PAT access
-      else {
-	if ( pfCandidates_.size() > 0 ) {
-	  return (fIndex < pfCandidates_.size() ?
-		  reco::PFCandidatePtr(&pfCandidates_, fIndex) : reco::PFCandidatePtr());
-
+      case CompatibilityEmbedded:
+	return (fIndex < pfCandidates_.size() ?
+		reco::PFCandidatePtr(&pfCandidates_, fIndex) : reco::PFCandidatePtr());
+      // Non-embedded access
+      default: {
+	Constituent dau = daughterPtr (fIndex);
+	const reco::PFCandidate* pfCandidate = dynamic_cast <const reco::PFCandidate*> (dau.get());
+	if (pfCandidate) {
+	  return reco::PFCandidatePtr(dau.id(), pfCandidate, dau.key() );
+	}
+	else {
+	  throw cms::Exception("Invalid Constituent") << "PFJet constituent is not of PFCandidate type";
 	}
       }
     }
-    // Non-embedded access
-    else {
-      Constituent dau = daughterPtr (fIndex);
-      const reco::PFCandidate* pfCandidate = dynamic_cast <const reco::PFCandidate*> (dau.get());
-      if (pfCandidate) {
-	return reco::PFCandidatePtr(dau.id(), pfCandidate, dau.key() );
-      }
-      else {
-	throw cms::Exception("Invalid Constituent") << "PFJet constituent is not of PFCandidate type";
-      }
-
-    }
-
-    return reco::PFCandidatePtr ();
 }
 
 std::vector<reco::PFCandidatePtr> const & Jet::getPFConstituents () const {
-  if ( !isPFCandidateCached_ || pfCandidates_.size() > 0 ) cachePFCandidates();
+  if ( !isPFCandidateCached_.isReady() ) cachePFCandidates();
   return pfCandidatesTemp_;
 }
 
+PFConstituentView Jet::pfConstituents () const {
+  switch ( pfCandidatesStorage() ) {
+    case FwdPtrEmbedded:        return PFConstituentView(pfCandidatesFwdPtr_);
+    case PoolEmbedded:          return PFConstituentView(unpackedPFCandidatePool());
+    case CompatibilityEmbedded: return PFConstituentView(pfCandidates_);
+    default:                    return PFConstituentView(static_cast<const reco::Jet &>(*this));
+  }
+}
+
+void Jet::fillPFConstituentArrays (ConstituentArrays & arrays) const {
+  // read the slimmed candidates of the pool directly, without unpacking them
+  if ( pfCandidatesStorage() == PoolEmbedded ) {
+    for ( PackedPFCandidateRefVector::const_iterator ipf = pfCandidatesPool_.begin(), iend = pfCandidatesPool_.end(); ipf != iend; ++ipf ) {
+      arrays.addConstituent( (*ipf)->pt(), (*ipf)->eta(), (*ipf)->phi(), (*ipf)->mass(), (*ipf)->charge(), (*ipf)->pdgId() );
+    }
+    arrays.endJet();
+    return;
+  }
+  PFConstituentView constituents = pfConstituents();
+  for ( PFConstituentView::const_iterator ipf = constituents.begin(), iend = constituents.end(); ipf != iend; ++ipf ) {
+    if ( *ipf == 0 ) throw cms::Exception("Invalid Constituent") << "PFJet constituent is not of PFCandidate type";
+    arrays.addConstituent( **ipf );
+  }
+  arrays.endJet();
+}
+
+void Jet::fillPFConstituentArrays (const std::vector<Jet> & jets, ConstituentArrays & arrays) {
+  arrays.clear();
+  // count from the stored references: pfConstituents() would unpack the pool of each jet
+  size_t nConstituents = 0;
+  for ( std::vector<Jet>::const_iterator ijet = jets.begin(); ijet != jets.end(); ++ijet ) {
+    nConstituents += ijet->numberOfDaughters();
+  }
+  arrays.reserve( jets.size(), nConstituents );
+  for ( std::vector<Jet>::const_iterator ijet = jets.begin(); ijet != jets.end(); ++ijet ) {
+    ijet->fillPFConstituentArrays( arrays );
+  }
+}
+
 
 
 /// return the matched generated jet
@@ -266,6 +301,52 @@ float Jet::jecFactor(const unsigned int& level, const JetCorrFactors::Flavor& fl
   return jec_.at(set).correction(level, flavor)/jec_.at(currentJECSet_).correction(currentJECLevel_, currentJECFlavor_);
 }
 
+/// correction factor to the level, flavor and set of the handle,
+/// starting from the current level
+float Jet::jecFactor(JecHandle& handle) const
+{
+  resolveJecHandle(handle);
+  return jecFactor(handle.levelIndex(), handle.flavor(), handle.setIndex());
+}
+
+/// resolve the handle against the correction factors of this jet, if needed
+void Jet::resolveJecHandle(JecHandle& handle) const
+{
+  if(!handle.isResolvedFor(jec_) && !handle.resolve(jec_)){
+    if(jecSet(handle.set())>=0 || (handle.set().empty() && jecSetsAvailable())){
+      throw cms::Exception("InvalidRequest") << "This JEC level " << handle.level() << " does not exist. \n";
+    }
+    throw cms::Exception("InvalidRequest") << "This jet does not carry any jet energy correction factor information \n"
+					   << "for a jet energy correction set with label " << handle.set() << "\n";
+  }
+}
+
+/// correct all the jets of a collection in place up to the level, flavor
+/// and set of the handle
+void Jet::correctJets(std::vector<Jet>& jets, JecHandle& handle)
+{
+  // gather the target and current factors of all jets into contiguous arrays
+  std::vector<float> factors(jets.size()), currentFactors(jets.size());
+  for(size_t idx=0; idx<jets.size(); ++idx){
+    const Jet& jet=jets[idx];
+    jet.resolveJecHandle(handle);
+    factors[idx]=jet.jec_[handle.setIndex()].correction(handle.levelIndex(), handle.flavor());
+    currentFactors[idx]=jet.jec_.at(jet.currentJECSet_).correction(jet.currentJECLevel_, jet.currentJECFlavor_);
+  }
+  // plain loop over the arrays, which the compiler can vectorize
+  float * factor=factors.empty() ? 0 : &factors[0];
+  const float * currentFactor=currentFactors.empty() ? 0 : &currentFactors[0];
+  for(size_t idx=0, n=factors.size(); idx<n; ++idx){
+    factor[idx]/=currentFactor[idx];
+  }
+  // rescale p4 and update current level, flavor and set
+  for(size_t idx=0; idx<jets.size(); ++idx){
+    Jet& jet=jets[idx];
+    jet.setP4(factor[idx]*jet.p4());
+    jet.currentJECSet(handle.setIndex()); jet.currentJECLevel(handle.levelIndex()); jet.currentJECFlavor(handle.flavor());
+  }
+}
+
 /// copy of the jet with correction factor to target step for
 /// the set of correction factors, which is currently in use
 Jet Jet::correctedJet(const std::string& level, const std::string& flavor, const std::string& set) const
@@ -301,51 +382,146 @@ Jet Jet::correctedJet(const unsigned int& level, const JetCorrFactors::Flavor& f
 /// ============= BTag information methods ============
 
 const std::vector<std::pair<std::string, float> > & Jet::getPairDiscri() const {
-   return pairDiscriVector_;
+  const DiscriminatorSchema * schema = bDiscriminatorSchema();
+  if (schema == 0) return pairDiscriVector_;
+  if (!isPairDiscriCached_.isReady()) {
+    std::vector<std::pair<std::string, float> > pairs;
+    pairs.reserve(bDiscriminators_.size());
+    for (unsigned int slot = 0; slot < bDiscriminators_.size() && slot < schema->size(); ++slot) {
+      if (bDiscriminators_[slot] != bDiscriminators_[slot]) continue; // not set for this jet
+      pairs.push_back(std::make_pair(schema->name(slot), bDiscriminators_[slot]));
+    }
+    if (isPairDiscriCached_.tryStartFill()) {
+      pairDiscriTemp_.swap(pairs);
+      isPairDiscriCached_.publish();
+    } else {
+      isPairDiscriCached_.waitReady();
+    }
+  }
+  return pairDiscriTemp_;
 }
 
 /// get b discriminant from label name
 float Jet::bDiscriminator(const std::string & aLabel) const {
-  float discriminator = -1000.;
   const std::string & theLabel = ((aLabel == "" || aLabel == "default")) ? "trackCountingHighEffBJetTags" : aLabel;
-  for(unsigned int i=0; i!=pairDiscriVector_.size(); i++){
-    if(pairDiscriVector_[i].first == theLabel){
-      discriminator = pairDiscriVector_[i].second;
-    }
+  const DiscriminatorSchema * schema = bDiscriminatorSchema();
+  if (schema != 0) {
+    int slot = schema->index(theLabel);
+    return (slot >= 0 ? bDiscriminator(slot) : -1000.);
   }
-  return discriminator;
+  // the last pair with the label wins, as when the pairs were scanned forward
+  for (std::vector<std::pair<std::string, float> >::const_reverse_iterator it = pairDiscriVector_.rbegin(); it != pairDiscriVector_.rend(); ++it) {
+    if (it->first == theLabel) return it->second;
+  }
+  return -1000.;
+}
+
+/// get b discriminant from a handle
+float Jet::bDiscriminator(DiscriminatorHandle & handle) const {
+  const DiscriminatorSchema * schema = bDiscriminatorSchema();
+  if (schema == 0) return bDiscriminator(handle.label());
+  int slot = handle.slot(schema);
+  return (slot >= 0 ? bDiscriminator(slot) : -1000.);
+}
+
+/// b discriminant of the handle for all the jets of a collection
+void Jet::bDiscriminators(const std::vector<Jet> & jets, DiscriminatorHandle & handle, std::vector<float> & values) {
+  values.resize(jets.size());
+  for (size_t i = 0, n = jets.size(); i < n; ++i) {
+    values[i] = jets[i].bDiscriminator(handle);
+  }
+}
+
+/// schema of the b discriminants of the collection; NULL if the schema product
+/// is not in the event (not kept when writing the file), so that the
+/// discriminants read as missing instead of throwing
+const DiscriminatorSchema * Jet::bDiscriminatorSchema() const {
+  return (bDiscriminatorSchema_.isNonnull() && bDiscriminatorSchema_.isAvailable() ? bDiscriminatorSchema_.get() : 0);
 }
 
 const reco::BaseTagInfo * Jet::tagInfo(const std::string &label) const {
     std::vector<std::string>::const_iterator it = std::find(tagInfoLabels_.begin(), tagInfoLabels_.end(), label);
-    if (it != tagInfoLabels_.end()) {
-      if ( tagInfosFwdPtr_.size() > 0 ) return tagInfosFwdPtr_[it - tagInfoLabels_.begin()].get();
-      else if ( tagInfos_.size() > 0 )  return & tagInfos_[it - tagInfoLabels_.begin()];
-      return 0;
-    }
+    if (it != tagInfoLabels_.end()) return tagInfoAt(it - tagInfoLabels_.begin());
     return 0;
 }
 
+/// tagInfo in the given slot, from the refactorized or the compatibility embedding
+const reco::BaseTagInfo * Jet::tagInfoAt(size_t slot) const {
+    switch ( tagInfosStorage() ) {
+      case FwdPtrEmbedded:        return tagInfosFwdPtr_[slot].get();
+      case CompatibilityEmbedded: return & tagInfos_[slot];
+      default:                    return 0;
+    }
+}
 
-template<typename T>
-const T *  Jet::tagInfoByType() const {
-  // First check the factorized PAT version
-    for (size_t i = 0, n = tagInfosFwdPtr_.size(); i < n; ++i) {
-      TagInfoFwdPtrCollection::value_type const & val = tagInfosFwdPtr_[i];
-      reco::BaseTagInfo const * baseTagInfo = val.get();
-      if ( typeid(*baseTagInfo) == typeid(T) ) {
-	return static_cast<const T *>( baseTagInfo );
+/// build the index of the types of the tagInfos; the tagInfos are
+/// dereferenced only here, not at each typed access
+void Jet::indexTagInfos() const {
+    std::vector<const std::type_info *> types;
+    std::vector<std::pair<const std::type_info *, unsigned int> > firstSlots;
+    size_t n = tagInfosSize();
+    types.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      const reco::BaseTagInfo * baseTagInfo = tagInfoAt(i);
+      const std::type_info * type = (baseTagInfo != 0 ? &typeid(*baseTagInfo) : 0);
+      types.push_back(type);
+      if (type == 0) continue;
+      bool known = false;
+      for (std::vector<std::pair<const std::type_info *, unsigned int> >::const_iterator it = firstSlots.begin(); it != firstSlots.end(); ++it) {
+        if (*it->first == *type) { known = true; break; }
       }
+      if (!known) firstSlots.push_back(std::make_pair(type, i));
     }
-    // Then check compatibility version
-    for (size_t i = 0, n = tagInfos_.size(); i < n; ++i) {
-      edm::OwnVector<reco::BaseTagInfo>::value_type const & val = tagInfos_[i];
-      reco::BaseTagInfo const * baseTagInfo = &val;
-      if ( typeid(*baseTagInfo) == typeid(T) ) {
-	return static_cast<const T *>( baseTagInfo );
+    if (isTagInfoIndexed_.tryStartFill()) {
+      tagInfoTypes_.swap(types);
+      tagInfoTypeSlots_.swap(firstSlots);
+      isTagInfoIndexed_.publish();
+    } else if (isTagInfoIndexed_.isReady() && tagInfoTypes_.size() != n && isTagInfoIndexed_.tryStartRefill()) {
+      // the published index is out of date, so no reader uses it; rewrite it only if no other
+      // thread has refilled it in between
+      if (tagInfoTypes_.size() != n) {
+        tagInfoTypes_.swap(types);
+        tagInfoTypeSlots_.swap(firstSlots);
       }
+      isTagInfoIndexed_.publish();
+    } else {
+      isTagInfoIndexed_.waitReady();
     }
-    return 0;
+}
+
+/// index of the types of the tagInfos, up to date with the stored tagInfos
+void Jet::checkTagInfoIndex() const {
+    if (!isTagInfoIndexed_.isReady() || tagInfoTypes_.size() != tagInfosSize()) {
+      indexTagInfos();
+    }
+}
+
+/// slot of the first tagInfo of the given type, -1 if there is none
+int Jet::tagInfoSlot(const std::type_info & type) const {
+    checkTagInfoIndex();
+    for (std::vector<std::pair<const std::type_info *, unsigned int> >::const_iterator it = tagInfoTypeSlots_.begin(); it != tagInfoTypeSlots_.end(); ++it) {
+      if (it->first == &type || *it->first == type) return it->second;
+    }
+    return -1;
+}
+
+template<typename T>
+const T *  Jet::tagInfoByType() const {
+    int slot = tagInfoSlot(typeid(T));
+    return (slot >= 0 ? static_cast<const T *>( tagInfoAt(slot) ) : 0);
+}
+
+template<typename T>
+const T *  Jet::tagInfoByLabel(const std::string &label) const {
+    std::vector<std::string>::const_iterator it = std::find(tagInfoLabels_.begin(), tagInfoLabels_.end(), label);
+    if (it == tagInfoLabels_.end()) return 0;
+    size_t slot = it - tagInfoLabels_.begin();
+    checkTagInfoIndex();
+    const std::type_info * type = (slot < tagInfoTypes_.size() ? tagInfoTypes_[slot] : 0);
+    if (type == 0) return 0;
+    // exact type from the index; derived types still need the cast
+    if (type == &typeid(T) || *type == typeid(T)) return static_cast<const T *>( tagInfoAt(slot) );
+    return dynamic_cast<const T *>( tagInfoAt(slot) );
 }
 
 
@@ -353,24 +529,28 @@ const T *  Jet::tagInfoByType() const {
 const reco::TrackIPTagInfo *
 Jet::tagInfoTrackIP(const std::string &label) const {
     return (label.empty() ? tagInfoByType<reco::TrackIPTagInfo>()
-                          : dynamic_cast<const reco::TrackIPTagInfo *>(tagInfo(label)) );
+                          : tagInfoByLabel<reco::TrackIPTagInfo>(label) );
 }
 
 const reco::SoftLeptonTagInfo *
 Jet::tagInfoSoftLepton(const std::string &label) const {
     return (label.empty() ? tagInfoByType<reco::SoftLeptonTagInfo>()
-                          : dynamic_cast<const reco::SoftLeptonTagInfo *>(tagInfo(label)) );
+                          : tagInfoByLabel<reco::SoftLeptonTagInfo>(label) );
 }
 
 const reco::SecondaryVertexTagInfo *
 Jet::tagInfoSecondaryVertex(const std::string &label) const {
     return (label.empty() ? tagInfoByType<reco::SecondaryVertexTagInfo>()
-                          : dynamic_cast<const reco::SecondaryVertexTagInfo *>(tagInfo(label)) );
+                          : tagInfoByLabel<reco::SecondaryVertexTagInfo>(label) );
 }
 
 void
 Jet::addTagInfo(const std::string &label,
 		const TagInfoFwdPtrCollection::value_type &info) {
+    if (tagInfosStorage() == CompatibilityEmbedded) {
+      throw cms::Exception("InvalidRequest") << "Jet::addTagInfo: this jet holds full copies of its tagInfos, as written by an old version of PAT;\n"
+                                             << "a tagInfo can not be added to them by reference.\n";
+    }
     std::string::size_type idx = label.find("TagInfos");
     if (idx == std::string::npos) {
       tagInfoLabels_.push_back(label);
@@ -378,6 +558,10 @@ Jet::addTagInfo(const std::string &label,
         tagInfoLabels_.push_back(label.substr(0,idx));
     }
     tagInfosFwdPtr_.push_back(info);
+    tagInfosStorage_ = FwdPtrEmbedded;
+    // index the types now, so that the typed accessors do not have to
+    isTagInfoIndexed_.reset();
+    indexTagInfos();
 }
 
 
@@ -399,42 +583,136 @@ void Jet::setAssociatedTracks(const reco::TrackRefVector &tracks) {
 
 /// method to store the CaloJet constituents internally
 void Jet::setCaloTowers(const CaloTowerFwdPtrCollection & caloTowers) {
+  // nothing to store: the constituents are still read as before, e.g. from the reco::Jet daughters
+  if ( caloTowers.empty() ) return;
   for(unsigned int i = 0; i < caloTowers.size(); ++i) {
     caloTowersFwdPtr_.push_back( caloTowers.at(i) );
   }
-  embeddedCaloTowers_ = true;
-  isCaloTowerCached_ = false;
+  caloTowers_.clear();
+  caloTowersStorage_ = FwdPtrEmbedded;
+  isCaloTowerCached_.reset();
 }
 
 
 /// method to store the CaloJet constituents internally
 void Jet::setPFCandidates(const PFCandidateFwdPtrCollection & pfCandidates) {
+  if ( pfCandidates.empty() ) return;
   for(unsigned int i = 0; i < pfCandidates.size(); ++i) {
     pfCandidatesFwdPtr_.push_back(pfCandidates.at(i));
   }
-  embeddedPFCandidates_ = true;
-  isPFCandidateCached_ = false;
+  pfCandidates_.clear();
+  pfCandidatesPool_.clear();
+  pfCandidatesPoolUnpacked_.clear();
+  pfCandidatesStorage_ = FwdPtrEmbedded;
+  isPFCandidateCached_.reset();
+  isPFCandidatePoolUnpacked_.reset();
+}
+
+/// method to store the PFCandidate constituents as references to the event-level pool
+void Jet::setPackedPFCandidates(const PackedPFCandidateRefVector & pfCandidates) {
+  if ( pfCandidates.empty() ) return;
+  pfCandidatesPool_ = pfCandidates;
+  pfCandidates_.clear();
+  pfCandidatesFwdPtr_.clear();
+  pfCandidatesStorage_ = PoolEmbedded;
+  isPFCandidateCached_.reset();
+  isPFCandidatePoolUnpacked_.reset();
+}
+
+/// unpack the slimmed candidates of the pool, once
+const reco::PFCandidateCollection & Jet::unpackedPFCandidatePool() const {
+  if ( !isPFCandidatePoolUnpacked_.isReady() ) {
+    reco::PFCandidateCollection unpacked;
+    unpacked.reserve( pfCandidatesPool_.size() );
+    for ( PackedPFCandidateRefVector::const_iterator ipf = pfCandidatesPool_.begin(), iend = pfCandidatesPool_.end(); ipf != iend; ++ipf ) {
+      unpacked.push_back( (*ipf)->unpack() );
+    }
+    if ( isPFCandidatePoolUnpacked_.tryStartFill() ) {
+      pfCandidatesPoolUnpacked_.swap(unpacked);
+      isPFCandidatePoolUnpacked_.publish();
+    } else {
+      isPFCandidatePoolUnpacked_.waitReady();
+    }
+  }
+  return pfCandidatesPoolUnpacked_;
 }
 
 
 /// method to set the matched generated jet reference, embedding if requested
+/// the summary of the generated jet is filled if the referenced collection is available
 void Jet::setGenJetRef(const edm::FwdRef<reco::GenJetCollection> & gj)
 {
   genJetFwdRef_ = gj;
+  GenJetSummary summary;
+  summary.partonFlavour = genJetSummary_.partonFlavour;
+  summary.hadronFlavour = genJetSummary_.hadronFlavour;
+  if ( gj.isNonnull() && gj.isAvailable() ) {
+    const reco::GenJet & genJet = *gj;
+    summary.pt   = genJet.pt();
+    summary.eta  = genJet.eta();
+    summary.phi  = genJet.phi();
+    summary.mass = genJet.mass();
+    summary.deltaR = reco::deltaR(*this, genJet);
+    summary.genJetIndex = gj.key();
+  }
+  genJetSummary_ = summary;
 }
 
-
+/// method to set the summary of the matched generated jet
+void Jet::setGenJetSummary(const GenJetSummary & summary) {
+  genJetSummary_ = summary;
+  partonFlavour_ = summary.partonFlavour;
+}
 
 /// method to set the flavour of the parton underlying the jet
 void Jet::setPartonFlavour(int partonFl) {
   partonFlavour_ = partonFl;
+  genJetSummary_.partonFlavour = partonFl;
 }
 
 /// method to add a algolabel-discriminator pair
 void Jet::addBDiscriminatorPair(const std::pair<std::string, float> & thePair) {
+  const DiscriminatorSchema * schema = bDiscriminatorSchema();
+  if (schema != 0) {
+    int slot = schema->index(thePair.first);
+    if (slot < 0) {
+      throw cms::Exception("InvalidRequest") << "The b discriminator " << thePair.first << " is not in the schema of this jet.\n";
+    }
+    setBDiscriminator(slot, thePair.second);
+    return;
+  }
   pairDiscriVector_.push_back(thePair);
 }
 
+/// method to set the schema of the b discriminants of the collection
+void Jet::setBDiscriminatorSchema(const DiscriminatorSchemaRefProd & schema, const DiscriminatorSchema * schemaContent) {
+  std::vector<std::pair<std::string, float> > pairs;
+  pairs.swap(pairDiscriVector_);
+  bDiscriminatorSchema_ = schema;
+  bDiscriminators_.clear();
+  isPairDiscriCached_.reset();
+  if (pairs.empty()) return;
+  const DiscriminatorSchema * content = (schemaContent != 0 ? schemaContent : bDiscriminatorSchema());
+  if (content == 0) {
+    pairDiscriVector_.swap(pairs);
+    return;
+  }
+  for (std::vector<std::pair<std::string, float> >::const_iterator it = pairs.begin(); it != pairs.end(); ++it) {
+    int slot = content->index(it->first);
+    if (slot < 0) {
+      throw cms::Exception("InvalidRequest") << "The b discriminator " << it->first << " is not in the schema of this jet.\n";
+    }
+    setBDiscriminator(slot, it->second);
+  }
+}
+
+/// method to set the b discriminant in a slot of the schema
+void Jet::setBDiscriminator(unsigned int slot, float value) {
+  if (slot >= bDiscriminators_.size()) bDiscriminators_.resize(slot+1, std::numeric_limits<float>::quiet_NaN());
+  bDiscriminators_[slot] = value;
+  isPairDiscriCached_.reset();
+}
+
 /// method to set the jet charge
 void Jet::setJetCharge(float jetCharge) {
   jetCharge_ = jetCharge;
@@ -444,84 +722,199 @@ void Jet::setJetCharge(float jetCharge) {
 
 /// method to cache the constituents to allow "user-friendly" access
 void Jet::cacheCaloTowers() const {
-  // Clear the cache
-  caloTowersTemp_.clear();
-  // Here is where we've embedded constituents
-  if ( embeddedCaloTowers_ ) {
-    // Refactorized PAT access
-    if ( caloTowersFwdPtr_.size() > 0 ) {
-      for ( CaloTowerFwdPtrVector::const_iterator ibegin=caloTowersFwdPtr_.begin(),
-	      iend = caloTowersFwdPtr_.end(),
-	      icalo = ibegin;
-	    icalo != iend; ++icalo ) {
-	caloTowersTemp_.push_back( CaloTowerPtr(icalo->ptr() ) );
-      }
+  // Fill a local vector first, then publish it into the cache
+  std::vector<CaloTowerPtr> caloTowers;
+  switch ( caloTowersStorage() ) {
+  // Refactorized PAT access
+  case FwdPtrEmbedded:
+    for ( CaloTowerFwdPtrVector::const_iterator ibegin=caloTowersFwdPtr_.begin(),
+	    iend = caloTowersFwdPtr_.end(),
+	    icalo = ibegin;
+	  icalo != iend; ++icalo ) {
+      caloTowers.push_back( CaloTowerPtr(icalo->ptr() ) );
     }
-    // Compatibility access
-    else if ( caloTowers_.size() > 0 ) {
-      for ( CaloTowerCollection::const_iterator ibegin=caloTowers_.begin(),
-	      iend = caloTowers_.end(),
-	      icalo = ibegin;
-	    icalo != iend; ++icalo ) {
-	caloTowersTemp_.push_back( CaloTowerPtr(&caloTowers_, icalo - ibegin ) );
-      }
+    break;
+  // Compatibility access
+  case CompatibilityEmbedded:
+    for ( CaloTowerCollection::const_iterator ibegin=caloTowers_.begin(),
+	    iend = caloTowers_.end(),
+	    icalo = ibegin;
+	  icalo != iend; ++icalo ) {
+      caloTowers.push_back( CaloTowerPtr(&caloTowers_, icalo - ibegin ) );
     }
-  }
+    break;
   // Non-embedded access
-  else {
+  default:
     for ( unsigned fIndex = 0; fIndex < numberOfDaughters(); ++fIndex ) {
       Constituent const & dau = daughterPtr (fIndex);
       const CaloTower* caloTower = dynamic_cast <const CaloTower*> (dau.get());
       if (caloTower) {
-	caloTowersTemp_.push_back( CaloTowerPtr(dau.id(), caloTower,dau.key() ) );
+	caloTowers.push_back( CaloTowerPtr(dau.id(), caloTower,dau.key() ) );
       }
       else {
 	throw cms::Exception("Invalid Constituent") << "CaloJet constituent is not of CaloTower type";
       }
     }
   }
-  // Set the cache flag
-  isCaloTowerCached_=true;
+  // Publish the cache, unless another thread did it first
+  if ( isCaloTowerCached_.tryStartFill() ) {
+    caloTowersTemp_.swap(caloTowers);
+    isCaloTowerCached_.publish();
+  } else {
+    isCaloTowerCached_.waitReady();
+  }
 }
 
 /// method to cache the constituents to allow "user-friendly" access
 void Jet::cachePFCandidates() const {
-  // Clear the cache
-  pfCandidatesTemp_.clear();
-  // Here is where we've embedded constituents
-  if ( embeddedPFCandidates_ ) {
-    // Refactorized PAT access
-    if ( pfCandidatesFwdPtr_.size() > 0 ) {
-      for ( PFCandidateFwdPtrCollection::const_iterator ibegin=pfCandidatesFwdPtr_.begin(),
-	      iend = pfCandidatesFwdPtr_.end(),
-	      ipf = ibegin;
-	    ipf != iend; ++ipf ) {
-	pfCandidatesTemp_.push_back( reco::PFCandidatePtr(ipf->ptr() ) );
-      }
+  // Fill a local vector first, then publish it into the cache
+  std::vector<reco::PFCandidatePtr> pfCandidates;
+  switch ( pfCandidatesStorage() ) {
+  // Refactorized PAT access
+  case FwdPtrEmbedded:
+    for ( PFCandidateFwdPtrCollection::const_iterator ibegin=pfCandidatesFwdPtr_.begin(),
+	    iend = pfCandidatesFwdPtr_.end(),
+	    ipf = ibegin;
+	  ipf != iend; ++ipf ) {
+      pfCandidates.push_back( reco::PFCandidatePtr(ipf->ptr() ) );
     }
-    // Compatibility access
-    else if ( pfCandidates_.size() > 0 ) {
-      for ( reco::PFCandidateCollection::const_iterator ibegin=pfCandidates_.begin(),
-	      iend = pfCandidates_.end(),
-	      ipf = ibegin;
-	    ipf != iend; ++ipf ) {
-	pfCandidatesTemp_.push_back( reco::PFCandidatePtr(&pfCandidates_, ipf - ibegin ) );
-      }
+    break;
+  // Event-level pool access
+  case PoolEmbedded: {
+    const reco::PFCandidateCollection & unpacked = unpackedPFCandidatePool();
+    for ( unsigned int ipf = 0; ipf < unpacked.size(); ++ipf ) {
+      pfCandidates.push_back( reco::PFCandidatePtr(&unpacked, ipf ) );
     }
+    break;
   }
+  // Compatibility access
+  case CompatibilityEmbedded:
+    for ( reco::PFCandidateCollection::const_iterator ibegin=pfCandidates_.begin(),
+	    iend = pfCandidates_.end(),
+	    ipf = ibegin;
+	  ipf != iend; ++ipf ) {
+      pfCandidates.push_back( reco::PFCandidatePtr(&pfCandidates_, ipf - ibegin ) );
+    }
+    break;
   // Non-embedded access
-  else {
+  default:
     for ( unsigned fIndex = 0; fIndex < numberOfDaughters(); ++fIndex ) {
       Constituent const & dau = daughterPtr (fIndex);
       const reco::PFCandidate* pfCandidate = dynamic_cast <const reco::PFCandidate*> (dau.get());
       if (pfCandidate) {
-	pfCandidatesTemp_.push_back( reco::PFCandidatePtr(dau.id(), pfCandidate,dau.key() ) );
+	pfCandidates.push_back( reco::PFCandidatePtr(dau.id(), pfCandidate,dau.key() ) );
       }
       else {
 	throw cms::Exception("Invalid Constituent") << "PFJet constituent is not of PFCandidate type";
       }
     }
   }
-  // Set the cache flag
-  isPFCandidateCached_=true;
+  // Publish the cache, unless another thread did it first
+  if ( isPFCandidateCached_.tryStartFill() ) {
+    pfCandidatesTemp_.swap(pfCandidates);
+    isPFCandidateCached_.publish();
+  } else {
+    isPFCandidateCached_.waitReady();
+  }
+}
+
+/// energy fractions and multiplicities used by the jet identification
+const JetEnergyFractions & Jet::energyFractions () const {
+  if ( energyFractionsState_.isReady() && energyFractionsEnergy_ == energy() ) return energyFractions_;
+  JetEnergyFractions fractions;
+  fillEnergyFractions( fractions );
+  if ( energyFractionsState_.tryStartFill() ) {
+    energyFractions_ = fractions;
+    energyFractionsEnergy_ = energy();
+    energyFractionsState_.publish();
+  } else if ( energyFractionsState_.isReady() && energyFractionsEnergy_ != energy() && energyFractionsState_.tryStartRefill() ) {
+    // the energy can only change through non-const methods, so a published cache which is out of date
+    // is not used by any reader; rewrite it only if no other thread has refilled it in between
+    if ( energyFractionsEnergy_ != energy() ) {
+      energyFractions_ = fractions;
+      energyFractionsEnergy_ = energy();
+    }
+    energyFractionsState_.publish();
+  } else {
+    energyFractionsState_.waitReady();
+  }
+  return energyFractions_;
+}
+
+/// compute the energy fractions relative to the uncorrected jet energy
+void Jet::fillEnergyFractions (JetEnergyFractions & fractions) const {
+  double uncorrectedEnergy = (jecSetsAvailable() ? jecFactor(0) : 1.)*energy();
+  double scale = (uncorrectedEnergy != 0 ? 1./uncorrectedEnergy : 0.);
+  if ( isPFJet() ) {
+    const PFSpecific & pf = specificPF_[0];
+    fractions.chargedHadron = pf.mChargedHadronEnergy*scale;
+    fractions.neutralHadron = pf.mNeutralHadronEnergy*scale;
+    fractions.chargedEm     = pf.mChargedEmEnergy*scale;
+    fractions.neutralEm     = pf.mNeutralEmEnergy*scale;
+    fractions.photon        = pf.mPhotonEnergy*scale;
+    fractions.electron      = pf.mElectronEnergy*scale;
+    fractions.muon          = pf.mMuonEnergy*scale;
+    fractions.chargedMu     = pf.mChargedMuEnergy*scale;
+    fractions.HFHadron      = pf.mHFHadronEnergy*scale;
+    fractions.HFEM          = pf.mHFEMEnergy*scale;
+    fractions.chargedMultiplicity = pf.mChargedMultiplicity;
+    fractions.neutralMultiplicity = pf.mNeutralMultiplicity;
+    fractions.muonMultiplicity    = pf.mMuonMultiplicity;
+  }
+  else if ( isJPTJet() ) {
+    fractions.chargedHadron = chargedHadronEnergy()*scale;
+    fractions.neutralHadron = neutralHadronEnergy()*scale;
+    fractions.chargedEm     = chargedEmEnergy()*scale;
+    fractions.neutralEm     = neutralEmEnergy()*scale;
+    fractions.chargedMultiplicity = chargedMultiplicity();
+    fractions.muonMultiplicity    = muonMultiplicity();
+  }
+  if ( !specificCalo_.empty() ) {
+    fractions.em       = specificCalo_[0].mEnergyFractionEm;
+    fractions.hadronic = specificCalo_[0].mEnergyFractionHadronic;
+  }
+  fractions.fHPD          = jetID_.fHPD;
+  fractions.n90Hits       = jetID_.n90Hits;
+  fractions.nConstituents = numberOfDaughters();
+}
+
+/// memory footprint
+void Jet::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  PATObject<reco::Jet>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(Jet));
+  report.addContainer("calo towers", caloTowersTemp_);
+  report.addItems("calo towers", caloTowers_);
+  report.addContainer("calo towers", caloTowersFwdPtr_);
+  report.addContainer("PF candidates", pfCandidatesTemp_);
+  report.addContainer("PF candidates", pfCandidates_);
+  report.addContainer("PF candidates", pfCandidatesFwdPtr_);
+  report.addItems("PF candidates", pfCandidatesPool_);
+  report.addContainer("PF candidates", pfCandidatesPoolUnpacked_);
+  report.addContainer("gen jet", genJet_);
+  report.addItems("gen jet", genJetRef_);
+  report.addContainer("jet corrections", jec_);
+  report.addContainer("b-tag discriminators", pairDiscriVector_);
+  report.addContainer("b-tag discriminators", bDiscriminators_);
+  report.add("b-tag discriminators", sizeof(bDiscriminatorSchema_), 0);
+  report.addContainer("b-tag discriminators", pairDiscriTemp_);
+  report.addContainer("labels", tagInfoLabels_);
+  report.addItems("tag infos", tagInfos_);
+  report.addContainer("tag infos", tagInfosFwdPtr_);
+  report.addItems("associated tracks", associatedTracks_);
+  report.addContainer("specific", specificCalo_);
+  report.addContainer("specific", specificJPT_);
+  report.addContainer("specific", specificPF_);
+}
+
+/// float precision
+void Jet::reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) {
+  PATObject<reco::Jet>::reduceFloatPrecision(policy);
+  for (std::vector<std::pair<std::string, float> >::iterator it = pairDiscriVector_.begin(), ed = pairDiscriVector_.end(); it != ed; ++it) {
+    it->second = policy.reduce(pat::FloatPrecisionPolicy::BDiscriminators, it->second);
+  }
+  policy.reduce(pat::FloatPrecisionPolicy::BDiscriminators, bDiscriminators_);
+  isPairDiscriCached_.reset();
+  for (std::vector<pat::JetCorrFactors>::iterator it = jec_.begin(), ed = jec_.end(); it != ed; ++it) {
+    it->reduceFloatPrecision(policy);
+  }
 }
@@ -2,6 +2,7 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cctype>
 
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
@@ -38,25 +39,43 @@ JetCorrFactors::JetCorrFactors(const std::string& label, const std::vector<Corre
   }
 }
 
+namespace {
+  // labels of the flavors, in the order of the Flavor enumerator
+  const char * const flavorLabels[] = { "gluon", "uds", "charm", "bottom", "none" };
+}
+
 std::string 
 JetCorrFactors::jecFlavor(const Flavor& flavor) const
 {
-  std::map<Flavor, std::string> flavors;
-  flavors[UDS]="uds"; flavors[CHARM]="charm"; flavors[BOTTOM]="bottom"; flavors[GLUON]="gluon"; flavors[NONE]="none"; 
-  return flavors.find(flavor)->second;
+  return flavorLabels[flavor];
+}
+
+bool
+JetCorrFactors::jecFlavor(const std::string& flavor, Flavor& result)
+{
+  for(unsigned int idx=0; idx<=NONE; ++idx){
+    const char * label = flavorLabels[idx];
+    std::string::const_iterator ch=flavor.begin();
+    for(; ch!=flavor.end() && *label!='\0'; ++ch, ++label){
+      if(std::tolower(*ch)!=*label) break;
+    }
+    if(ch==flavor.end() && *label=='\0'){
+      result = (Flavor)idx;
+      return true;
+    }
+  }
+  return false;
 }
 
 JetCorrFactors::Flavor 
-JetCorrFactors::jecFlavor(std::string flavor) const
+JetCorrFactors::jecFlavor(const std::string& flavor) const
 {
-  std::map<std::string, Flavor> flavors;
-  std::transform(flavor.begin(), flavor.end(), flavor.begin(), std::ptr_fun<int,int>(std::tolower));
-  flavors["uds"]=UDS; flavors["charm"]=CHARM; flavors["bottom"]=BOTTOM; flavors["gluon"]=GLUON; flavors["none"]=NONE;
-  if(flavors.find(flavor)==flavors.end()){
+  Flavor result;
+  if(!jecFlavor(flavor, result)){
     throw cms::Exception("InvalidRequest") << "You ask for a flavor, which does not exist. Available flavors are: \n"
 					   << "'uds', 'charm', 'bottom', 'gluon', 'none', (not case sensitive).   \n";
   }
-  return flavors.find(flavor)->second;
+  return result;
 }
 
 int  
@@ -126,3 +145,11 @@ JetCorrFactors::print() const
     message << "\n";
   }
 }
+
+void
+JetCorrFactors::reduceFloatPrecision(const FloatPrecisionPolicy& policy)
+{
+  for(std::vector<CorrectionFactor>::iterator corrFactor=jec_.begin(); corrFactor!=jec_.end(); ++corrFactor){
+    policy.reduce(FloatPrecisionPolicy::JecFactors, corrFactor->second);
+  }
+}
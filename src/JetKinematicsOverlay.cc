@@ -0,0 +1,91 @@
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "DataFormats/PatCandidates/interface/JetKinematicsOverlay.h"
+
+
+using namespace pat;
+
+
+unsigned int
+JetKinematicsOverlay::growVariations(unsigned int nVariations)
+{
+  unsigned int first = names_.size();
+  variedPt_.resize((first+nVariations)*nJets());
+  variedMass_.resize((first+nVariations)*nJets());
+  return first;
+}
+
+unsigned int
+JetKinematicsOverlay::addVariation(const std::string& name, const std::vector<float>& scales)
+{
+  return addVariations(std::vector<std::string>(1, name), scales);
+}
+
+unsigned int
+JetKinematicsOverlay::addVariations(const std::vector<std::string>& names, const std::vector<float>& scales)
+{
+  const unsigned int n = nJets(), nK = names.size();
+  if(scales.size()!=nK*n){
+    throw cms::Exception("InvalidRequest") << "JetKinematicsOverlay: " << scales.size() << " scale factors given for "
+					   << nK << " variations of " << n << " jets.\n";
+  }
+  unsigned int first = growVariations(nK);
+  names_.insert(names_.end(), names.begin(), names.end());
+  if(n==0) return first;
+  // one pass over contiguous arrays, which the compiler can vectorize
+  const float * scale = &scales[0];
+  const float * pt = &pt_[0];
+  const float * mass = &mass_[0];
+  float * variedPt = &variedPt_[first*n];
+  float * variedMass = &variedMass_[first*n];
+  for(unsigned int k=0; k<nK; ++k, scale+=n, variedPt+=n, variedMass+=n){
+    for(unsigned int i=0; i<n; ++i){
+      variedPt[i] = scale[i]*pt[i];
+      variedMass[i] = scale[i]*mass[i];
+    }
+  }
+  return first;
+}
+
+unsigned int
+JetKinematicsOverlay::addUpDownVariations(const std::string& name, const std::vector<float>& uncertainties)
+{
+  const unsigned int n = nJets();
+  if(uncertainties.size()!=n){
+    throw cms::Exception("InvalidRequest") << "JetKinematicsOverlay: " << uncertainties.size() << " uncertainties given for "
+					   << n << " jets.\n";
+  }
+  std::vector<std::string> names;
+  names.push_back(name+"Up");
+  names.push_back(name+"Down");
+  std::vector<float> scales(2*n);
+  for(unsigned int i=0; i<n; ++i){
+    scales[i] = 1.f+uncertainties[i];
+    scales[n+i] = 1.f-uncertainties[i];
+  }
+  return addVariations(names, scales);
+}
+
+int
+JetKinematicsOverlay::variationIndex(const std::string& name) const
+{
+  for(std::vector<std::string>::const_iterator it=names_.begin(); it!=names_.end(); ++it){
+    if(*it==name) return (it-names_.begin());
+  }
+  return -1;
+}
+
+JetKinematicsOverlay::MetShift
+JetKinematicsOverlay::metShift(unsigned int k, float minPt) const
+{
+  MetShift shift;
+  const unsigned int n = nJets();
+  const float * variedPt = pts(k);
+  for(unsigned int i=0; i<n; ++i){
+    if(variedPt[i]<=minPt) continue;
+    float dPt = variedPt[i]-pt_[i];
+    shift.px -= dPt*cosPhi_[i];
+    shift.py -= dPt*sinPhi_[i];
+    shift.sumEt += dPt;
+  }
+  return shift;
+}
@@ -82,58 +82,83 @@ float MET::uncorrectedPhi(UncorrectionType ix) const {
 
 //! check and set transients
 void MET::checkUncor_() const {
-  if (uncorInfo_.size() == uncorrMAXN && oldPt_ == pt() ) return;
+  if (uncorInfoState_.isReady() && oldPt_ == pt()) return;
+
+  std::vector<UncorInfo> uncorInfo;
+  unsigned int nCorrections;
+  fillUncor_(uncorInfo, nCorrections);
+
+  if (uncorInfoState_.tryStartFill()) {
+    storeUncor_(uncorInfo, nCorrections);
+    uncorInfoState_.publish();
+  } else if (uncorInfoState_.isReady() && oldPt_ != pt() && uncorInfoState_.tryStartRefill()) {
+    // the pt can only change through non-const methods, which do not run concurrently with readers:
+    // a published cache is rewritten only if it is still out of date, i.e. no reader can be using it
+    if (oldPt_ != pt()) storeUncor_(uncorInfo, nCorrections);
+    uncorInfoState_.publish();
+  } else {
+    uncorInfoState_.waitReady();
+  }
+}
 
+//! store the uncorrection transients, while the cache state is Filling
+void MET::storeUncor_(std::vector<UncorInfo> & uncorInfo, unsigned int nCorrections) const {
+  uncorInfo_.swap(uncorInfo);
+  nCorrections_ = nCorrections;
   oldPt_ = pt();
+}
+
+//! compute the uncorrection transients
+void MET::fillUncor_(std::vector<UncorInfo> & uncorInfo, unsigned int & nCorrections) const {
   std::vector<CorrMETData> corrs(mEtCorr());
-  nCorrections_ = corrs.size();
+  nCorrections = corrs.size();
 
-  uncorInfo_.resize(uncorrMAXN);
+  uncorInfo.resize(uncorrMAXN);
   UncorrectionType ix;
 
   //! ugly
   //! ALL
   ix = uncorrALL;
-  uncorInfo_[ix] = UncorInfo();
-  for (unsigned int iC=0; iC < nCorrections_; ++iC){
-    uncorInfo_[ix].corEx +=    corrs[iC].mex;
-    uncorInfo_[ix].corEy +=    corrs[iC].mey;
-    uncorInfo_[ix].corSumEt += corrs[iC].sumet;
+  uncorInfo[ix] = UncorInfo();
+  for (unsigned int iC=0; iC < nCorrections; ++iC){
+    uncorInfo[ix].corEx +=    corrs[iC].mex;
+    uncorInfo[ix].corEy +=    corrs[iC].mey;
+    uncorInfo[ix].corSumEt += corrs[iC].sumet;
   }
-  setPtPhi_(uncorInfo_[ix]);
+  setPtPhi_(uncorInfo[ix]);
 
   //! JES
   ix = uncorrJES;
-  uncorInfo_[ix] = UncorInfo();
-  if (nCorrections_ >=1 ){
+  uncorInfo[ix] = UncorInfo();
+  if (nCorrections >=1 ){
     unsigned int iC = 0;
-    uncorInfo_[ix].corEx +=    corrs[iC].mex;
-    uncorInfo_[ix].corEy +=    corrs[iC].mey;
-    uncorInfo_[ix].corSumEt += corrs[iC].sumet;
+    uncorInfo[ix].corEx +=    corrs[iC].mex;
+    uncorInfo[ix].corEy +=    corrs[iC].mey;
+    uncorInfo[ix].corSumEt += corrs[iC].sumet;
   }
-  setPtPhi_(uncorInfo_[ix]);
+  setPtPhi_(uncorInfo[ix]);
 
   //! MUON
   ix = uncorrMUON;
-  uncorInfo_[ix] = UncorInfo();
-  if (nCorrections_ >=2 ){
+  uncorInfo[ix] = UncorInfo();
+  if (nCorrections >=2 ){
     unsigned int iC = 1;
-    uncorInfo_[ix].corEx +=    corrs[iC].mex;
-    uncorInfo_[ix].corEy +=    corrs[iC].mey;
-    uncorInfo_[ix].corSumEt += corrs[iC].sumet;
+    uncorInfo[ix].corEx +=    corrs[iC].mex;
+    uncorInfo[ix].corEy +=    corrs[iC].mey;
+    uncorInfo[ix].corSumEt += corrs[iC].sumet;
   }
-  setPtPhi_(uncorInfo_[ix]);
+  setPtPhi_(uncorInfo[ix]);
 
   //! TAU
   ix = uncorrTAU;
-  uncorInfo_[ix] = UncorInfo();
-  if (nCorrections_ >=3 ){
+  uncorInfo[ix] = UncorInfo();
+  if (nCorrections >=3 ){
     unsigned int iC = 2;
-    uncorInfo_[ix].corEx +=    corrs[iC].mex;
-    uncorInfo_[ix].corEy +=    corrs[iC].mey;
-    uncorInfo_[ix].corSumEt += corrs[iC].sumet;
+    uncorInfo[ix].corEx +=    corrs[iC].mex;
+    uncorInfo[ix].corEy +=    corrs[iC].mey;
+    uncorInfo[ix].corSumEt += corrs[iC].sumet;
   }
-  setPtPhi_(uncorInfo_[ix]);
+  setPtPhi_(uncorInfo[ix]);
 
 }
 
@@ -143,3 +168,12 @@ void MET::setPtPhi_(UncorInfo& uci) const {
   uci.pt = sqrt(lpx*lpx + lpy*lpy);
   uci.phi = atan2(lpy, lpx);
 }
+
+void MET::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  PATObject<reco::MET>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(MET));
+  report.addContainer("gen MET", genMET_);
+  report.addContainer("specific", caloMET_);
+  report.addContainer("specific", pfMET_);
+  report.addContainer("uncorrected MET cache", uncorInfo_);
+}
@@ -0,0 +1,114 @@
+#include "DataFormats/PatCandidates/interface/MemoryFootprint.h"
+
+#include <iostream>
+#include <iomanip>
+
+using namespace pat;
+
+size_t pat::memory::heapSize(const std::vector<std::string> & v) {
+    size_t ret = v.capacity() * sizeof(std::string);
+    for (std::vector<std::string>::const_iterator it = v.begin(), ed = v.end(); it != ed; ++it) {
+        ret += heapSize(*it);
+    }
+    return ret;
+}
+
+namespace {
+    void addToEntries(std::vector<MemoryFootprint::Entry> & entries, const std::string & category, size_t inlineBytes, size_t heapBytes) {
+        for (std::vector<MemoryFootprint::Entry>::iterator it = entries.begin(), ed = entries.end(); it != ed; ++it) {
+            if (it->category == category) {
+                it->inlineBytes += inlineBytes;
+                it->heapBytes   += heapBytes;
+                return;
+            }
+        }
+        entries.push_back(MemoryFootprint::Entry(category, inlineBytes, heapBytes));
+    }
+
+    void printRow(std::ostream & out, const std::string & category, size_t inlineBytes, size_t heapBytes,
+                  size_t nObjects, size_t grandTotal) {
+        size_t total = inlineBytes + heapBytes;
+        out << std::setw(24) << std::left << category << std::right
+            << std::setw(14) << inlineBytes
+            << std::setw(14) << heapBytes
+            << std::setw(14) << total
+            << std::setw(16) << std::fixed << std::setprecision(1) << (nObjects ? double(total)/nObjects : 0.)
+            << std::setw(10) << std::fixed << std::setprecision(1) << (grandTotal ? 100.*total/grandTotal : 0.) << "%"
+            << std::endl;
+    }
+
+    void printTable(std::ostream & out, const std::vector<MemoryFootprint::Entry> & entries, size_t objectBytes, size_t nObjects) {
+        size_t inlineSum = 0, heapSum = 0;
+        for (std::vector<MemoryFootprint::Entry>::const_iterator it = entries.begin(), ed = entries.end(); it != ed; ++it) {
+            inlineSum += it->inlineBytes;
+            heapSum   += it->heapBytes;
+        }
+        size_t other = (objectBytes > inlineSum ? objectBytes - inlineSum : 0);
+        size_t grandTotal = objectBytes + heapSum;
+        out << std::setw(24) << std::left << "category" << std::right
+            << std::setw(14) << "inline [B]"
+            << std::setw(14) << "heap [B]"
+            << std::setw(14) << "total [B]"
+            << std::setw(16) << "per object [B]"
+            << std::setw(11) << "fraction"
+            << std::endl;
+        for (std::vector<MemoryFootprint::Entry>::const_iterator it = entries.begin(), ed = entries.end(); it != ed; ++it) {
+            printRow(out, it->category, it->inlineBytes, it->heapBytes, nObjects, grandTotal);
+        }
+        printRow(out, "other (inline)", other, 0, nObjects, grandTotal);
+        printRow(out, "total", objectBytes, heapSum, nObjects, grandTotal);
+    }
+}
+
+void MemoryFootprint::add(const std::string & category, size_t inlineBytes, size_t heapBytes) {
+    addToEntries(entries_, category, inlineBytes, heapBytes);
+}
+
+size_t MemoryFootprint::otherInlineBytes() const {
+    size_t inlineSum = 0;
+    for (std::vector<Entry>::const_iterator it = entries_.begin(), ed = entries_.end(); it != ed; ++it) {
+        inlineSum += it->inlineBytes;
+    }
+    return (objectSize_ > inlineSum ? objectSize_ - inlineSum : 0);
+}
+
+size_t MemoryFootprint::heapBytes() const {
+    size_t ret = 0;
+    for (std::vector<Entry>::const_iterator it = entries_.begin(), ed = entries_.end(); it != ed; ++it) {
+        ret += it->heapBytes;
+    }
+    return ret;
+}
+
+void MemoryFootprint::print(std::ostream & out) const {
+    printTable(out, entries_, objectSize_, 1);
+}
+
+void MemoryFootprintTable::add(const MemoryFootprint & footprint) {
+    ++nObjects_;
+    objectBytes_ += footprint.objectSize();
+    for (std::vector<MemoryFootprint::Entry>::const_iterator it = footprint.entries().begin(), ed = footprint.entries().end(); it != ed; ++it) {
+        addToEntries(totals_, it->category, it->inlineBytes, it->heapBytes);
+    }
+}
+
+void MemoryFootprintTable::clear() {
+    totals_.clear();
+    nObjects_ = 0;
+    objectBytes_ = 0;
+}
+
+void MemoryFootprintTable::print(std::ostream & out) const {
+    out << "Memory footprint of " << nObjects_ << " objects" << std::endl;
+    printTable(out, totals_, objectBytes_, nObjects_);
+}
+
+std::ostream & pat::operator<<(std::ostream & out, const MemoryFootprint & footprint) {
+    footprint.print(out);
+    return out;
+}
+
+std::ostream & pat::operator<<(std::ostream & out, const MemoryFootprintTable & table) {
+    table.print(out);
+    return out;
+}
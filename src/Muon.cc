@@ -4,6 +4,7 @@
 
 #include "DataFormats/PatCandidates/interface/Muon.h"
 #include "DataFormats/MuonReco/interface/MuonSelectors.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
 #include "FWCore/Utilities/interface/Exception.h"
 
 #include <limits>
@@ -14,6 +15,7 @@ using namespace pat;
 /// default constructor
 Muon::Muon() :
     Lepton<reco::Muon>(),
+    embeddedMuonBestTrack_(false),
     embeddedTrack_(false),
     embeddedStandAloneMuon_(false),
     embeddedCombinedMuon_(false),
@@ -38,6 +40,7 @@ Muon::Muon() :
 /// constructor from reco::Muon
 Muon::Muon(const reco::Muon & aMuon) :
     Lepton<reco::Muon>(aMuon),
+    embeddedMuonBestTrack_(false),
     embeddedTrack_(false),
     embeddedStandAloneMuon_(false),
     embeddedCombinedMuon_(false),
@@ -62,6 +65,7 @@ Muon::Muon(const reco::Muon & aMuon) :
 /// constructor from ref to reco::Muon
 Muon::Muon(const edm::RefToBase<reco::Muon> & aMuonRef) :
     Lepton<reco::Muon>(aMuonRef),
+    embeddedMuonBestTrack_(false),
     embeddedTrack_(false),
     embeddedStandAloneMuon_(false),
     embeddedCombinedMuon_(false),
@@ -86,6 +90,7 @@ Muon::Muon(const edm::RefToBase<reco::Muon> & aMuonRef) :
 /// constructor from ref to reco::Muon
 Muon::Muon(const edm::Ptr<reco::Muon> & aMuonRef) :
     Lepton<reco::Muon>(aMuonRef),
+    embeddedMuonBestTrack_(false),
     embeddedTrack_(false),
     embeddedStandAloneMuon_(false),
     embeddedCombinedMuon_(false),
@@ -138,10 +143,20 @@ void Muon::initImpactParameters() {
 }
 
 
+/// reference to Track selected to be the best measurement of the muon parameters (reimplemented from reco::Muon)
+reco::TrackRef Muon::muonBestTrack() const {
+  if (embeddedMuonBestTrack_) {
+    return embeddedTrack(BestTrackRole, muonBestTrack_);
+  } else {
+    return reco::Muon::muonBestTrack();
+  }
+}
+
+
 /// reference to Track reconstructed in the tracker only (reimplemented from reco::Muon)
 reco::TrackRef Muon::track() const {
   if (embeddedTrack_) {
-    return reco::TrackRef(&track_, 0);
+    return embeddedTrack(InnerTrackRole, track_);
   } else {
     return reco::Muon::innerTrack();
   }
@@ -151,7 +166,7 @@ reco::TrackRef Muon::track() const {
 /// reference to Track reconstructed in the muon detector only (reimplemented from reco::Muon)
 reco::TrackRef Muon::standAloneMuon() const {
   if (embeddedStandAloneMuon_) {
-    return reco::TrackRef(&standAloneMuon_, 0);
+    return embeddedTrack(OuterTrackRole, standAloneMuon_);
   } else {
     return reco::Muon::outerTrack();
   }
@@ -161,7 +176,7 @@ reco::TrackRef Muon::standAloneMuon() const {
 /// reference to Track reconstructed in both tracked and muon detector (reimplemented from reco::Muon)
 reco::TrackRef Muon::combinedMuon() const {
   if (embeddedCombinedMuon_) {
-    return reco::TrackRef(&combinedMuon_, 0);
+    return embeddedTrack(GlobalTrackRole, combinedMuon_);
   } else {
     return reco::Muon::globalTrack();
   }
@@ -170,7 +185,7 @@ reco::TrackRef Muon::combinedMuon() const {
 /// reference to Track reconstructed using hits in the tracker + "good" muon hits
 reco::TrackRef Muon::pickyTrack() const {
   if (embeddedPickyMuon_) {
-    return reco::TrackRef(&pickyMuon_, 0);
+    return embeddedTrack(PickyTrackRole, pickyMuon_);
   } else {
     return reco::Muon::pickyTrack();
   }
@@ -179,7 +194,7 @@ reco::TrackRef Muon::pickyTrack() const {
 /// reference to Track reconstructed using hits in the tracker + info from the first muon station that has hits
 reco::TrackRef Muon::tpfmsTrack() const {
   if (embeddedTpfmsMuon_) {
-    return reco::TrackRef(&tpfmsMuon_, 0);
+    return embeddedTrack(TpfmsTrackRole, tpfmsMuon_);
   } else {
     return reco::Muon::tpfmsTrack();
   }
@@ -188,12 +203,45 @@ reco::TrackRef Muon::tpfmsTrack() const {
 /// reference to Track reconstructed using hits in the tracker + info from the first muon station that has hits
 reco::TrackRef Muon::dytTrack() const {
   if (embeddedDytMuon_) {
-    return reco::TrackRef(&dytMuon_, 0);
+    return embeddedTrack(DytTrackRole, dytMuon_);
   } else {
     return reco::Muon::dytTrack();
   }
 }
 
+/// embedded track of a role: from the pool of embedded tracks, or else from the per-role
+/// vector of files written before the pool
+reco::TrackRef Muon::embeddedTrack(TrackRole role, const std::vector<reco::Track> & roleTracks) const {
+  unsigned int slot = (embeddedTrackSlots_.empty() ? 0 : embeddedTrackSlots_[role]);
+  if (slot != 0) return reco::TrackRef(&embeddedTracks_, slot - 1);
+  if (!roleTracks.empty()) return reco::TrackRef(&roleTracks, 0);
+  return reco::TrackRef();
+}
+
+/// embed the track of a role; a track identical to one already embedded for another role
+/// (e.g. the best track and the global track) is not copied again
+bool Muon::embedRoleTrack(TrackRole role, const reco::TrackRef & source) {
+  if (source.isNull()) return false;
+  if (embeddedTrackSlots_.empty()) embeddedTrackSlots_.resize(NumberOfTrackRoles, 0);
+  const reco::Track & track = *source;
+  for (size_t slot = 0; slot < embeddedTracks_.size(); ++slot) {
+    if (sameTrack(embeddedTracks_[slot], track)) {
+      embeddedTrackSlots_[role] = slot + 1;
+      return true;
+    }
+  }
+  embeddedTracks_.push_back(track);
+  embeddedTrackSlots_[role] = embeddedTracks_.size();
+  return true;
+}
+
+/// true if two tracks are copies of the same fit
+bool Muon::sameTrack(const reco::Track & a, const reco::Track & b) {
+  return a.chi2() == b.chi2() && a.ndof() == b.ndof() && a.charge() == b.charge() &&
+         a.parameters() == b.parameters() && a.referencePoint() == b.referencePoint() &&
+         a.numberOfValidHits() == b.numberOfValidHits() && a.numberOfLostHits() == b.numberOfLostHits();
+}
+
 /// reference to the source IsolatedPFCandidates
 reco::PFCandidateRef Muon::pfCandidateRef() const {
   if (embeddedPFCandidate_) {
@@ -215,8 +263,7 @@ reco::CandidatePtr Muon::sourceCandidatePtr( size_type i ) const {
 /// embed the Track selected to be the best measurement of the muon parameters
 void Muon::embedMuonBestTrack() {
   muonBestTrack_.clear();
-  if (reco::Muon::muonBestTrack().isNonnull()) {
-      muonBestTrack_.push_back(*reco::Muon::muonBestTrack());
+  if (embedRoleTrack(BestTrackRole, reco::Muon::muonBestTrack())) {
       embeddedMuonBestTrack_ = true;
   }
 }
@@ -226,8 +273,7 @@ void Muon::embedMuonBestTrack() {
 /// embed the Track reconstructed in the tracker only
 void Muon::embedTrack() {
   track_.clear();
-  if (reco::Muon::innerTrack().isNonnull()) {
-      track_.push_back(*reco::Muon::innerTrack());
+  if (embedRoleTrack(InnerTrackRole, reco::Muon::innerTrack())) {
       embeddedTrack_ = true;
   }
 }
@@ -236,8 +282,7 @@ void Muon::embedTrack() {
 /// embed the Track reconstructed in the muon detector only
 void Muon::embedStandAloneMuon() {
   standAloneMuon_.clear();
-  if (reco::Muon::outerTrack().isNonnull()) {
-      standAloneMuon_.push_back(*reco::Muon::outerTrack());
+  if (embedRoleTrack(OuterTrackRole, reco::Muon::outerTrack())) {
       embeddedStandAloneMuon_ = true;
   }
 }
@@ -246,8 +291,7 @@ void Muon::embedStandAloneMuon() {
 /// embed the Track reconstructed in both tracked and muon detector
 void Muon::embedCombinedMuon() {
   combinedMuon_.clear();
-  if (reco::Muon::globalTrack().isNonnull()) {
-      combinedMuon_.push_back(*reco::Muon::globalTrack());
+  if (embedRoleTrack(GlobalTrackRole, reco::Muon::globalTrack())) {
       embeddedCombinedMuon_ = true;
   }
 }
@@ -269,9 +313,7 @@ void Muon::embedTcMETMuonCorrs(const reco::MuonMETCorrectionData& t) {
 /// embed the picky Track
 void Muon::embedPickyMuon() {
   pickyMuon_.clear();
-  reco::TrackRef tk = reco::Muon::pickyTrack();
-  if (tk.isNonnull()) {
-    pickyMuon_.push_back(*tk);
+  if (embedRoleTrack(PickyTrackRole, reco::Muon::pickyTrack())) {
     embeddedPickyMuon_ = true;
   }
 }
@@ -279,9 +321,7 @@ void Muon::embedPickyMuon() {
 /// embed the tpfms Track
 void Muon::embedTpfmsMuon() {
   tpfmsMuon_.clear();
-  reco::TrackRef tk = reco::Muon::tpfmsTrack();
-  if (tk.isNonnull()) {
-    tpfmsMuon_.push_back(*tk);
+  if (embedRoleTrack(TpfmsTrackRole, reco::Muon::tpfmsTrack())) {
     embeddedTpfmsMuon_ = true;
   }
 }
@@ -289,9 +329,7 @@ void Muon::embedTpfmsMuon() {
 /// embed the dyt Track
 void Muon::embedDytMuon() {
   dytMuon_.clear();
-  reco::TrackRef tk = reco::Muon::dytTrack();
-  if (tk.isNonnull()) {
-    dytMuon_.push_back(*tk);
+  if (embedRoleTrack(DytTrackRole, reco::Muon::dytTrack())) {
     embeddedDytMuon_ = true;
   }
 }
@@ -318,6 +356,8 @@ bool Muon::muonID(const std::string& name) const {
 double Muon::normChi2() const {
   if ( cachedNormChi2_ ) {
     return normChi2_;
+  } else if ( trackSummary_.global.present ) {
+    return trackSummary_.global.normChi2;
   } else {
     reco::TrackRef t = globalTrack();
     return t->chi2() / t->ndof();
@@ -331,6 +371,8 @@ double Muon::normChi2() const {
 unsigned int Muon::numberOfValidHits() const {
   if ( cachedNumberOfValidHits_ ) {
     return numberOfValidHits_;
+  } else if ( trackSummary_.inner.present ) {
+    return trackSummary_.inner.validHits;
   } else {
     reco::TrackRef t = innerTrack();
     return t->numberOfValidHits();
@@ -393,6 +435,7 @@ double Muon::segmentCompatibility(reco::Muon::ArbitrationType arbitrationType) c
 
 // Selectors
 bool Muon::isTightMuon(const reco::Vertex&vtx) const {
+  if ( trackSummary_.isFilled() ) return trackSummary_.isTightMuon(vtx.position());
   return muon::isTightMuon(*this, vtx);
 }
 
@@ -401,7 +444,13 @@ bool Muon::isLooseMuon() const {
 
 }
 
+bool Muon::isMediumMuon() const {
+  if ( trackSummary_.isFilled() ) return trackSummary_.isMediumMuon();
+  return makeTrackSummary().isMediumMuon();
+}
+
 bool Muon::isSoftMuon(const reco::Vertex& vtx) const {
+  if ( trackSummary_.isFilled() ) return trackSummary_.isSoftMuon(vtx.position());
   return muon::isSoftMuon(*this, vtx);
 }
 
@@ -410,3 +459,40 @@ bool Muon::isHighPtMuon(const reco::Vertex& vtx) const{
   return muon::isHighPtMuon(*this, vtx);
 }
 
+
+/// summary of the track quality, from the embedded tracks if any
+pat::MuonTrackSummary Muon::makeTrackSummary() const {
+  pat::MuonTrackSummary summary;
+  summary.fill(*this, innerTrack(), globalTrack(), muonBestTrack());
+  return summary;
+}
+
+
+void Muon::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  Lepton<reco::Muon>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(Muon));
+  report.addContainer("embedded tracks", embeddedTracks_);
+  report.addContainer("embedded tracks", embeddedTrackSlots_);
+  report.addContainer("embedded tracks", muonBestTrack_);
+  report.addContainer("embedded tracks", track_);
+  report.addContainer("embedded tracks", standAloneMuon_);
+  report.addContainer("embedded tracks", combinedMuon_);
+  report.addContainer("embedded tracks", pickyMuon_);
+  report.addContainer("embedded tracks", tpfmsMuon_);
+  report.addContainer("embedded tracks", dytMuon_);
+  report.addContainer("MET corrections", tcMETMuonCorrs_);
+  report.addContainer("MET corrections", caloMETMuonCorrs_);
+  report.addContainer("PF candidates", pfCandidate_);
+  report.addContainer("impact parameters", cachedIP_);
+  report.addContainer("impact parameters", ip_);
+  report.addContainer("impact parameters", eip_);
+}
+
+/// float precision
+void Muon::reduceFloatPrecision(const pat::FloatPrecisionPolicy & policy) {
+  Lepton<reco::Muon>::reduceFloatPrecision(policy);
+  dB_ = policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, dB_);
+  edB_ = policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, edB_);
+  policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, ip_);
+  policy.reduce(pat::FloatPrecisionPolicy::ImpactParameters, eip_);
+}
@@ -0,0 +1,77 @@
+#include "DataFormats/PatCandidates/interface/MuonIdEvaluator.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+
+#include <cmath>
+
+
+using namespace pat;
+
+
+void
+MuonIdEvaluator::evaluate(const std::vector<Muon> & muons, const reco::Vertex & vertex, std::vector<unsigned char> & ids)
+{
+  const size_t n = muons.size();
+  ids.resize(n);
+  if(n==0) return;
+  flags_.resize(n);
+  innerNormChi2_.resize(n); innerValidFraction_.resize(n); innerAbsDxy_.resize(n); innerAbsDz_.resize(n);
+  globalNormChi2_.resize(n); bestAbsDxy_.resize(n); bestAbsDz_.resize(n);
+  chi2LocalPosition_.resize(n); trkKink_.resize(n); segmentCompatibility_.resize(n);
+  innerLayers_.resize(n); innerPixelLayers_.resize(n); innerPixelHits_.resize(n); globalMuonHits_.resize(n); matchedStations_.resize(n);
+
+  // gather the variables of all the muons into one array each
+  const math::XYZPoint & point = vertex.position();
+  MuonTrackSummary computed;
+  for(size_t i=0; i<n; ++i){
+    const MuonTrackSummary * summary = &muons[i].trackSummary();
+    if(!summary->isFilled()){
+      computed = muons[i].makeTrackSummary();
+      summary = &computed;
+    }
+    flags_[i] = summary->flags;
+    innerNormChi2_[i] = summary->inner.normChi2;
+    innerValidFraction_[i] = summary->inner.validFraction;
+    innerAbsDxy_[i] = std::abs(summary->inner.dxy(point));
+    innerAbsDz_[i] = std::abs(summary->inner.dz(point));
+    innerLayers_[i] = summary->inner.trackerLayers;
+    innerPixelLayers_[i] = summary->inner.pixelLayers;
+    innerPixelHits_[i] = summary->inner.validPixelHits;
+    globalNormChi2_[i] = summary->global.normChi2;
+    globalMuonHits_[i] = summary->global.validMuonHits;
+    bestAbsDxy_[i] = std::abs(summary->best.dxy(point));
+    bestAbsDz_[i] = std::abs(summary->best.dz(point));
+    chi2LocalPosition_[i] = summary->chi2LocalPosition;
+    trkKink_[i] = summary->trkKink;
+    segmentCompatibility_[i] = summary->segmentCompatibility;
+    matchedStations_[i] = summary->matchedStations;
+  }
+
+  // apply the cuts without branches, so that the compiler can vectorize the loop
+  const uint8_t * flags = &flags_[0];
+  const float * innerNormChi2 = &innerNormChi2_[0];
+  const float * innerValidFraction = &innerValidFraction_[0];
+  const float * innerAbsDxy = &innerAbsDxy_[0];
+  const float * innerAbsDz = &innerAbsDz_[0];
+  const float * globalNormChi2 = &globalNormChi2_[0];
+  const float * bestAbsDxy = &bestAbsDxy_[0];
+  const float * bestAbsDz = &bestAbsDz_[0];
+  const float * chi2LocalPosition = &chi2LocalPosition_[0];
+  const float * trkKink = &trkKink_[0];
+  const float * segmentCompatibility = &segmentCompatibility_[0];
+  const int * innerLayers = &innerLayers_[0];
+  const int * innerPixelLayers = &innerPixelLayers_[0];
+  const int * innerPixelHits = &innerPixelHits_[0];
+  const int * globalMuonHits = &globalMuonHits_[0];
+  const int * matchedStations = &matchedStations_[0];
+  unsigned char * result = &ids[0];
+  for(size_t i=0; i<n; ++i){
+    unsigned char loose = MuonTrackSummary::looseCuts(flags[i]);
+    unsigned char medium = MuonTrackSummary::mediumCuts(flags[i], innerValidFraction[i], globalNormChi2[i],
+                                                        chi2LocalPosition[i], trkKink[i], segmentCompatibility[i]);
+    unsigned char tight = MuonTrackSummary::tightCuts(flags[i], globalNormChi2[i], globalMuonHits[i], matchedStations[i],
+                                                      innerLayers[i], innerPixelHits[i], bestAbsDxy[i], bestAbsDz[i]);
+    unsigned char soft = MuonTrackSummary::softCuts(flags[i], innerLayers[i], innerPixelLayers[i], innerNormChi2[i],
+                                                    innerAbsDxy[i], innerAbsDz[i]);
+    result[i] = loose * Loose | medium * Medium | tight * Tight | soft * Soft;
+  }
+}
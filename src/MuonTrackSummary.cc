@@ -0,0 +1,54 @@
+#include "DataFormats/PatCandidates/interface/MuonTrackSummary.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/MuonReco/interface/MuonSelectors.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+#include <algorithm>
+
+
+using namespace pat;
+
+
+namespace {
+  uint8_t saturate(int value) { return uint8_t(std::min(std::max(value, 0), 255)); }
+}
+
+void
+MuonTrackQuality::fill(const reco::Track & track)
+{
+  const reco::HitPattern & hits = track.hitPattern();
+  normChi2 = track.normalizedChi2();
+  ptError = track.ptError();
+  int valid = hits.numberOfValidTrackerHits();
+  int lost = hits.numberOfLostTrackerHits() + track.trackerExpectedHitsInner().numberOfLostTrackerHits()
+                                            + track.trackerExpectedHitsOuter().numberOfLostTrackerHits();
+  validFraction = (valid + lost > 0 ? float(valid) / (valid + lost) : 0.f);
+  vx = track.vx(); vy = track.vy(); vz = track.vz();
+  px = track.px(); py = track.py(); pz = track.pz();
+  validHits = saturate(track.numberOfValidHits());
+  validPixelHits = saturate(hits.numberOfValidPixelHits());
+  validMuonHits = saturate(hits.numberOfValidMuonHits());
+  trackerLayers = saturate(hits.trackerLayersWithMeasurement());
+  pixelLayers = saturate(hits.pixelLayersWithMeasurement());
+  present = true;
+}
+
+void
+MuonTrackSummary::fill(const reco::Muon & muon, const reco::TrackRef & innerTrack, const reco::TrackRef & globalTrack, const reco::TrackRef & bestTrack)
+{
+  inner = MuonTrackQuality();
+  global = MuonTrackQuality();
+  best = MuonTrackQuality();
+  if (innerTrack.isNonnull()) inner.fill(*innerTrack);
+  if (globalTrack.isNonnull()) global.fill(*globalTrack);
+  if (bestTrack.isNonnull()) best.fill(*bestTrack);
+  segmentCompatibility = muon::segmentCompatibility(muon);
+  chi2LocalPosition = muon.combinedQuality().chi2LocalPosition;
+  trkKink = muon.combinedQuality().trkKink;
+  matchedStations = saturate(muon.numberOfMatchedStations());
+  flags = Filled;
+  if (muon.isPFMuon()) flags |= PFMuon;
+  if (muon.isGlobalMuon()) flags |= GlobalMuon;
+  if (muon.isTrackerMuon()) flags |= TrackerMuon;
+  if (muon::isGoodMuon(muon, muon::TMOneStationTight)) flags |= TMOneStationTight;
+}
@@ -0,0 +1,64 @@
+#include "DataFormats/PatCandidates/interface/PFJetIdEvaluator.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+#include <cmath>
+
+
+using namespace pat;
+
+
+PFJetIdEvaluator::WorkingPoint
+PFJetIdEvaluator::loose()
+{
+  return WorkingPoint();
+}
+
+PFJetIdEvaluator::WorkingPoint
+PFJetIdEvaluator::tight()
+{
+  WorkingPoint wp;
+  wp.maxNeutralHadronFraction = 0.90;
+  wp.maxNeutralEmFraction = 0.90;
+  return wp;
+}
+
+void
+PFJetIdEvaluator::evaluate(const std::vector<Jet> & jets, std::vector<unsigned char> & pass)
+{
+  const size_t n = jets.size();
+  pass.resize(n);
+  if(n==0) return;
+  neutralHadron_.resize(n); neutralEm_.resize(n); chargedHadron_.resize(n); chargedEm_.resize(n); absEta_.resize(n);
+  nConstituents_.resize(n); chargedMultiplicity_.resize(n);
+
+  // gather the variables of all the jets into one array each
+  for(size_t i=0; i<n; ++i){
+    if(!jets[i].isPFJet()){
+      throw cms::Exception("Type Mismatch") << "PFJetIdEvaluator: jet " << i << " was not made from a PFJet.\n";
+    }
+    const JetEnergyFractions & fractions = jets[i].energyFractions();
+    neutralHadron_[i] = fractions.neutralHadron;
+    neutralEm_[i] = fractions.neutralEm;
+    chargedHadron_[i] = fractions.chargedHadron;
+    chargedEm_[i] = fractions.chargedEm;
+    nConstituents_[i] = fractions.nConstituents;
+    chargedMultiplicity_[i] = fractions.chargedMultiplicity;
+    absEta_[i] = std::abs(jets[i].eta());
+  }
+
+  // apply the cuts without branches, so that the compiler can vectorize the loop
+  const WorkingPoint & wp = workingPoint_;
+  const float * nhf = &neutralHadron_[0];
+  const float * nef = &neutralEm_[0];
+  const float * chf = &chargedHadron_[0];
+  const float * cef = &chargedEm_[0];
+  const float * absEta = &absEta_[0];
+  const int * nConstituents = &nConstituents_[0];
+  const int * chm = &chargedMultiplicity_[0];
+  unsigned char * result = &pass[0];
+  for(size_t i=0; i<n; ++i){
+    unsigned char neutral = (nhf[i] < wp.maxNeutralHadronFraction) & (nef[i] < wp.maxNeutralEmFraction) & (nConstituents[i] >= wp.minConstituents);
+    unsigned char charged = (chf[i] > wp.minChargedHadronFraction) & (chm[i] >= wp.minChargedMultiplicity) & (cef[i] < wp.maxChargedEmFraction);
+    result[i] = neutral & (charged | (absEta[i] >= wp.maxChargedAbsEta));
+  }
+}
@@ -12,3 +12,8 @@ using namespace pat;
 PFParticle::PFParticle(const edm::RefToBase<reco::PFCandidate>& aPFParticle) : PATObject<reco::PFCandidate>(aPFParticle) {
 }
 
+/// memory footprint
+void PFParticle::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  PATObject<reco::PFCandidate>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(PFParticle));
+}
@@ -21,3 +21,10 @@ Particle::Particle(const reco::LeafCandidate & aParticle) : PATObject<reco::Leaf
 /// destructor
 Particle::~Particle() {
 }
+
+
+/// memory footprint
+void Particle::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  PATObject<reco::LeafCandidate>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(Particle));
+}
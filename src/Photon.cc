@@ -78,22 +78,34 @@ void Photon::embedSuperCluster() {
 
 // method to retrieve a photon ID (or throw)
 Bool_t Photon::photonID(const std::string & name) const {
-  for (std::vector<IdPair>::const_iterator it = photonIDs_.begin(), ed = photonIDs_.end(); it != ed; ++it) {
-    if (it->first == name) return it->second;
-  }
-  cms::Exception ex("Key not found");
-  ex << "pat::Photon: the ID " << name << " can't be found in this pat::Photon.\n";
-  ex << "The available IDs are: ";
-  for (std::vector<IdPair>::const_iterator it = photonIDs_.begin(), ed = photonIDs_.end(); it != ed; ++it) {
-    ex << "'" << it->first << "' ";
-  }
-  ex << ".\n";
-  throw ex;
+  return photonIDPairs_.get(photonIDStore_, photonIDs_, name, "pat::Photon");
+}
+// method to retrieve a photon ID from a handle (or throw)
+Bool_t Photon::photonID(DiscriminatorHandle & handle) const {
+  Bool_t value;
+  if (photonID(handle, value)) return value;
+  return photonID(handle.label());
+}
+// method to retrieve a photon ID without throwing
+bool Photon::photonID(const std::string & name, Bool_t & value) const {
+  return IdPairs<Bool_t>::get(photonIDStore_, photonIDs_, name, value);
+}
+// method to retrieve a photon ID from a handle without throwing
+bool Photon::photonID(DiscriminatorHandle & handle, Bool_t & value) const {
+  return IdPairs<Bool_t>::get(photonIDStore_, photonIDs_, handle, value);
 }
 // check if an ID is there
 bool Photon::isPhotonIDAvailable(const std::string & name) const {
-  for (std::vector<IdPair>::const_iterator it = photonIDs_.begin(), ed = photonIDs_.end(); it != ed; ++it) {
-    if (it->first == name) return true;
-  }
-  return false;
+  Bool_t value;
+  return photonID(name, value);
+}
+
+void Photon::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  PATObject<reco::Photon>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(Photon));
+  report.addContainer("embedded clusters", superCluster_);
+  report.addContainer("IDs", photonIDs_);
+  report.addContainer("IDs", photonIDStore_.floats());
+  report.addContainer("isolation", isoDeposits_);
+  report.addContainer("isolation", isolations_);
 }
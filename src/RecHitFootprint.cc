@@ -0,0 +1,99 @@
+#include "DataFormats/PatCandidates/interface/RecHitFootprint.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+#include "DataFormats/EcalDetId/interface/EcalSubdetector.h"
+
+#include <algorithm>
+
+
+using namespace pat;
+
+
+void
+RecHitFootprint::fill(const EcalRecHitCollection & recHits, const std::vector<DetId> & window)
+{
+  clear();
+  std::vector<uint32_t> ids;
+  ids.reserve(window.size());
+  for(std::vector<DetId>::const_iterator it = window.begin(); it != window.end(); ++it) ids.push_back(it->rawId());
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  for(std::vector<uint32_t>::const_iterator id = ids.begin(); id != ids.end(); ++id){
+    EcalRecHitCollection::const_iterator hit = recHits.find(DetId(*id));
+    if(hit == recHits.end()) continue;
+    uint32_t bits = 0;
+    for(int bit = 0; bit < 32; ++bit){
+      if(hit->checkFlag(bit)) bits |= (uint32_t(1) << bit);
+    }
+    detIds_.push_back(*id);
+    energies_.push_back(hit->energy());
+    times_.push_back(hit->time());
+    flags_.push_back(hit->flags());
+    flagBits_.push_back(bits);
+  }
+}
+
+void
+RecHitFootprint::clear()
+{
+  detIds_.clear(); energies_.clear(); times_.clear(); flags_.clear(); flagBits_.clear();
+}
+
+int
+RecHitFootprint::index(DetId id) const
+{
+  std::vector<uint32_t>::const_iterator it = std::lower_bound(detIds_.begin(), detIds_.end(), id.rawId());
+  return (it != detIds_.end() && *it == id.rawId()) ? int(it - detIds_.begin()) : -1;
+}
+
+EcalRecHit
+RecHitFootprint::recHit(size_t i) const
+{
+  return EcalRecHit(DetId(detIds_[i]), energies_[i], times_[i], flags_[i], flagBits_[i]);
+}
+
+void
+RecHitFootprint::unpack(EcalRecHitCollection & recHits) const
+{
+  recHits = EcalRecHitCollection();
+  recHits.reserve(size());
+  // already sorted by detector id, as EcalRecHitCollection::find expects
+  for(size_t i = 0, n = size(); i < n; ++i) recHits.push_back(recHit(i));
+}
+
+void
+RecHitFootprint::addSquareWindow(DetId center, int halfWidth, std::vector<DetId> & window)
+{
+  if(center.det() != DetId::Ecal) return;
+  if(center.subdetId() == EcalBarrel){
+    EBDetId seed(center);
+    for(int dEta = -halfWidth; dEta <= halfWidth; ++dEta){
+      // there is no ieta = 0 in the barrel
+      int ieta = seed.ieta() + dEta;
+      if(seed.ieta() < 0 && ieta >= 0) ++ieta;
+      if(seed.ieta() > 0 && ieta <= 0) --ieta;
+      for(int dPhi = -halfWidth; dPhi <= halfWidth; ++dPhi){
+        int iphi = ((seed.iphi() - 1 + dPhi) % EBDetId::MAX_IPHI + EBDetId::MAX_IPHI) % EBDetId::MAX_IPHI + 1;
+        if(EBDetId::validDetId(ieta, iphi)) window.push_back(EBDetId(ieta, iphi));
+      }
+    }
+  } else if(center.subdetId() == EcalEndcap){
+    EEDetId seed(center);
+    for(int dx = -halfWidth; dx <= halfWidth; ++dx){
+      for(int dy = -halfWidth; dy <= halfWidth; ++dy){
+        int ix = seed.ix() + dx, iy = seed.iy() + dy;
+        if(EEDetId::validDetId(ix, iy, seed.zside())) window.push_back(EEDetId(ix, iy, seed.zside()));
+      }
+    }
+  }
+}
+
+void
+RecHitFootprint::addSuperClusterWindow(const reco::SuperCluster & superCluster, int haloHalfWidth, std::vector<DetId> & window)
+{
+  const std::vector<std::pair<DetId, float> > & hits = superCluster.hitsAndFractions();
+  for(std::vector<std::pair<DetId, float> >::const_iterator it = hits.begin(); it != hits.end(); ++it){
+    if(haloHalfWidth > 0) addSquareWindow(it->first, haloHalfWidth, window);
+    else window.push_back(it->first);
+  }
+}
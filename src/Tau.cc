@@ -5,37 +5,81 @@
 #include "DataFormats/PatCandidates/interface/Tau.h"
 #include "DataFormats/JetReco/interface/GenJet.h"
 
+#include <algorithm>
+
 
 using namespace pat;
 
 
+namespace {
+  /// embed a subset of the signal or isolation candidates of a PFTau as the positions of its candidates
+  /// in the stored signal or isolation candidates. These are the full vector if it is embedded; otherwise
+  /// they only hold, as internal storage, the candidates of the embedded subsets, which do not overlap.
+  /// The subset is embedded as copies if one of its candidates is not in the full vector; the Refs
+  /// made from the previous storage of the subset are discarded through refsFixed
+  void embedPFCandSubset(const reco::PFCandidateRefVector & subset, const reco::PFCandidateRefVector & all, bool allEmbedded,
+                         std::vector<reco::PFCandidate> & stored, std::vector<reco::PFCandidate> & copies,
+                         std::vector<uint16_t> & indices, bool & subsetEmbedded, pat::CacheState & refsFixed) {
+    if (subsetEmbedded && !allEmbedded) return; // its candidates are stored already
+    refsFixed.reset();
+    copies.clear();
+    indices.clear();
+    indices.reserve(subset.size());
+    subsetEmbedded = true;
+    if (!allEmbedded) {
+      for (reco::PFCandidateRefVector::const_iterator cand = subset.begin(); cand != subset.end(); ++cand) {
+        indices.push_back(stored.size());
+        stored.push_back(**cand);
+      }
+      return;
+    }
+    for (reco::PFCandidateRefVector::const_iterator cand = subset.begin(); cand != subset.end(); ++cand) {
+      reco::PFCandidateRefVector::const_iterator match = std::find(all.begin(), all.end(), *cand);
+      if (match == all.end()) {
+        indices.clear();
+        for (reco::PFCandidateRefVector::const_iterator it = subset.begin(); it != subset.end(); ++it) copies.push_back(**it);
+        return;
+      }
+      indices.push_back(match - all.begin());
+    }
+  }
+
+  /// view over the embedded candidates of a subset, from its copies in old files or from its indices
+  TauPFCandidateView pfCandSubsetView(const std::vector<reco::PFCandidate> & copies, const std::vector<reco::PFCandidate> & all,
+                                      const std::vector<uint16_t> & indices) {
+    if (!copies.empty()) return TauPFCandidateView(copies);
+    return TauPFCandidateView(all, indices);
+  }
+
+  /// refs to the embedded candidates of a subset, from its copies in old files or from its indices
+  void fillPFCandSubsetRefs(const std::vector<reco::PFCandidate> & copies, const std::vector<reco::PFCandidate> & all,
+                            const std::vector<uint16_t> & indices, reco::PFCandidateRefVector & refs) {
+    if (!copies.empty()) {
+      for (unsigned int i = 0; i < copies.size(); i++) refs.push_back(reco::PFCandidateRef(&copies, i));
+    } else {
+      for (unsigned int i = 0; i < indices.size(); i++) refs.push_back(reco::PFCandidateRef(&all, indices[i]));
+    }
+  }
+}
+
+
 /// default constructor
 Tau::Tau() :
     Lepton<reco::BaseTau>()
     ,embeddedIsolationTracks_(false)
-    ,isolationTracksTransientRefVectorFixed_(false)
     ,embeddedLeadTrack_(false)
     ,embeddedSignalTracks_(false)
-    ,signalTracksTransientRefVectorFixed_(false)
     ,embeddedLeadPFCand_(false)
     ,embeddedLeadPFChargedHadrCand_(false)
     ,embeddedLeadPFNeutralCand_(false)
     ,embeddedSignalPFCands_(false)
-    ,signalPFCandsRefVectorFixed_(false)
     ,embeddedSignalPFChargedHadrCands_(false)
-    ,signalPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFNeutralHadrCands_(false)
-    ,signalPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFGammaCands_(false)
-    ,signalPFGammaCandsRefVectorFixed_(false)
     ,embeddedIsolationPFCands_(false)
-    ,isolationPFCandsRefVectorFixed_(false)
     ,embeddedIsolationPFChargedHadrCands_(false)
-    ,isolationPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFNeutralHadrCands_(false)
-    ,isolationPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFGammaCands_(false)
-    ,isolationPFGammaCandsRefVectorFixed_(false)
 {
 }
 
@@ -43,29 +87,19 @@ Tau::Tau() :
 Tau::Tau(const reco::BaseTau & aTau) :
     Lepton<reco::BaseTau>(aTau)
     ,embeddedIsolationTracks_(false)
-    ,isolationTracksTransientRefVectorFixed_(false)
     ,embeddedLeadTrack_(false)
     ,embeddedSignalTracks_(false)
-    ,signalTracksTransientRefVectorFixed_(false)
     ,embeddedLeadPFCand_(false)
     ,embeddedLeadPFChargedHadrCand_(false)
     ,embeddedLeadPFNeutralCand_(false)
     ,embeddedSignalPFCands_(false)
-    ,signalPFCandsRefVectorFixed_(false)
     ,embeddedSignalPFChargedHadrCands_(false)
-    ,signalPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFNeutralHadrCands_(false)
-    ,signalPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFGammaCands_(false)
-    ,signalPFGammaCandsRefVectorFixed_(false)
     ,embeddedIsolationPFCands_(false)
-    ,isolationPFCandsRefVectorFixed_(false)
     ,embeddedIsolationPFChargedHadrCands_(false)
-    ,isolationPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFNeutralHadrCands_(false)
-    ,isolationPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFGammaCands_(false)
-    ,isolationPFGammaCandsRefVectorFixed_(false)
 {
     const reco::PFTau * pfTau = dynamic_cast<const reco::PFTau *>(&aTau);
     if (pfTau != 0) pfSpecific_.push_back(pat::tau::TauPFSpecific(*pfTau));
@@ -77,29 +111,19 @@ Tau::Tau(const reco::BaseTau & aTau) :
 Tau::Tau(const edm::RefToBase<reco::BaseTau> & aTauRef) :
     Lepton<reco::BaseTau>(aTauRef)
     ,embeddedIsolationTracks_(false)
-    ,isolationTracksTransientRefVectorFixed_(false)
     ,embeddedLeadTrack_(false)
     ,embeddedSignalTracks_(false)
-    ,signalTracksTransientRefVectorFixed_(false)
     ,embeddedLeadPFCand_(false)
     ,embeddedLeadPFChargedHadrCand_(false)
     ,embeddedLeadPFNeutralCand_(false)
     ,embeddedSignalPFCands_(false)
-    ,signalPFCandsRefVectorFixed_(false)
     ,embeddedSignalPFChargedHadrCands_(false)
-    ,signalPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFNeutralHadrCands_(false)
-    ,signalPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFGammaCands_(false)
-    ,signalPFGammaCandsRefVectorFixed_(false)
     ,embeddedIsolationPFCands_(false)
-    ,isolationPFCandsRefVectorFixed_(false)
     ,embeddedIsolationPFChargedHadrCands_(false)
-    ,isolationPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFNeutralHadrCands_(false)
-    ,isolationPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFGammaCands_(false)
-    ,isolationPFGammaCandsRefVectorFixed_(false)
 {
     const reco::PFTau * pfTau = dynamic_cast<const reco::PFTau *>(aTauRef.get());
     if (pfTau != 0) pfSpecific_.push_back(pat::tau::TauPFSpecific(*pfTau));
@@ -111,29 +135,19 @@ Tau::Tau(const edm::RefToBase<reco::BaseTau> & aTauRef) :
 Tau::Tau(const edm::Ptr<reco::BaseTau> & aTauRef) :
     Lepton<reco::BaseTau>(aTauRef)
     ,embeddedIsolationTracks_(false)
-    ,isolationTracksTransientRefVectorFixed_(false)
     ,embeddedLeadTrack_(false)
     ,embeddedSignalTracks_(false)
-    ,signalTracksTransientRefVectorFixed_(false)
     ,embeddedLeadPFCand_(false)
     ,embeddedLeadPFChargedHadrCand_(false)
     ,embeddedLeadPFNeutralCand_(false)
     ,embeddedSignalPFCands_(false)
-    ,signalPFCandsRefVectorFixed_(false)
     ,embeddedSignalPFChargedHadrCands_(false)
-    ,signalPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFNeutralHadrCands_(false)
-    ,signalPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedSignalPFGammaCands_(false)
-    ,signalPFGammaCandsRefVectorFixed_(false)
     ,embeddedIsolationPFCands_(false)
-    ,isolationPFCandsRefVectorFixed_(false)
     ,embeddedIsolationPFChargedHadrCands_(false)
-    ,isolationPFChargedHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFNeutralHadrCands_(false)
-    ,isolationPFNeutralHadrCandsRefVectorFixed_(false)
     ,embeddedIsolationPFGammaCands_(false)
-    ,isolationPFGammaCandsRefVectorFixed_(false)
 {
     const reco::PFTau * pfTau = dynamic_cast<const reco::PFTau *>(aTauRef.get());
     if (pfTau != 0) pfSpecific_.push_back(pat::tau::TauPFSpecific(*pfTau));
@@ -165,13 +179,17 @@ reco::operator<<(std::ostream& out, const pat::Tau& obj)
 /// override the reco::BaseTau::isolationTracks method, to access the internal storage of the track
 const reco::TrackRefVector & Tau::isolationTracks() const {
   if (embeddedIsolationTracks_) {
-    if (!isolationTracksTransientRefVectorFixed_) {
+    if (!isolationTracksTransientRefVectorFixed_.isReady()) {
         reco::TrackRefVector trackRefVec;
         for (unsigned int i = 0; i < isolationTracks_.size(); i++) {
           trackRefVec.push_back(reco::TrackRef(&isolationTracks_, i));
         }
-        isolationTracksTransientRefVector_.swap(trackRefVec);
-        isolationTracksTransientRefVectorFixed_ = true;
+        if (isolationTracksTransientRefVectorFixed_.tryStartFill()) {
+          isolationTracksTransientRefVector_.swap(trackRefVec);
+          isolationTracksTransientRefVectorFixed_.publish();
+        } else {
+          isolationTracksTransientRefVectorFixed_.waitReady();
+        }
     }
     return isolationTracksTransientRefVector_;
   } else {
@@ -193,13 +211,17 @@ reco::TrackRef Tau::leadTrack() const {
 /// override the reco::BaseTau::track method, to access the internal storage of the track
 const reco::TrackRefVector & Tau::signalTracks() const {
   if (embeddedSignalTracks_) {
-    reco::TrackRefVector trackRefVec;
-    if (!signalTracksTransientRefVectorFixed_) {
+    if (!signalTracksTransientRefVectorFixed_.isReady()) {
+        reco::TrackRefVector trackRefVec;
         for (unsigned int i = 0; i < signalTracks_.size(); i++) {
           trackRefVec.push_back(reco::TrackRef(&signalTracks_, i));
         }
-        signalTracksTransientRefVector_.swap(trackRefVec);
-        signalTracksTransientRefVectorFixed_ = true;
+        if (signalTracksTransientRefVectorFixed_.tryStartFill()) {
+          signalTracksTransientRefVector_.swap(trackRefVec);
+          signalTracksTransientRefVectorFixed_.publish();
+        } else {
+          signalTracksTransientRefVectorFixed_.waitReady();
+        }
     }
     return signalTracksTransientRefVector_;
   } else {
@@ -208,6 +230,19 @@ const reco::TrackRefVector & Tau::signalTracks() const {
 }
 
 
+/// view over the isolation tracks
+TauTrackView Tau::isolationTracksView() const {
+  if (embeddedIsolationTracks_) return TauTrackView(isolationTracks_);
+  return TauTrackView(reco::BaseTau::isolationTracks());
+}
+
+/// view over the signal tracks
+TauTrackView Tau::signalTracksView() const {
+  if (embeddedSignalTracks_) return TauTrackView(signalTracks_);
+  return TauTrackView(reco::BaseTau::signalTracks());
+}
+
+
 /// method to store the isolation tracks internally
 void Tau::embedIsolationTracks() {
   isolationTracks_.clear();
@@ -254,24 +289,26 @@ const reco::GenJet * Tau::genJet() const {
 
 // method to retrieve a tau ID (or throw)
 float Tau::tauID(const std::string & name) const {
-  for (std::vector<IdPair>::const_iterator it = tauIDs_.begin(), ed = tauIDs_.end(); it != ed; ++it) {
-    if (it->first == name) return it->second;
-  }
-  cms::Exception ex("Key not found");
-  ex << "pat::Tau: the ID " << name << " can't be found in this pat::Tau.\n";
-  ex << "The available IDs are: ";
-  for (std::vector<IdPair>::const_iterator it = tauIDs_.begin(), ed = tauIDs_.end(); it != ed; ++it) {
-    ex << "'" << it->first << "' ";
-  }
-  ex << ".\n";
-  throw ex;
+  return tauIDPairs_.get(tauIDStore_, tauIDs_, name, "pat::Tau");
+}
+// method to retrieve a tau ID from a handle (or throw)
+float Tau::tauID(DiscriminatorHandle & handle) const {
+  float value;
+  if (tauID(handle, value)) return value;
+  return tauID(handle.label());
+}
+// method to retrieve a tau ID without throwing
+bool Tau::tauID(const std::string & name, float & value) const {
+  return IdPairs<float>::get(tauIDStore_, tauIDs_, name, value);
+}
+// method to retrieve a tau ID from a handle without throwing
+bool Tau::tauID(DiscriminatorHandle & handle, float & value) const {
+  return IdPairs<float>::get(tauIDStore_, tauIDs_, handle, value);
 }
 // check if an ID is there
 bool Tau::isTauIDAvailable(const std::string & name) const {
-  for (std::vector<IdPair>::const_iterator it = tauIDs_.begin(), ed = tauIDs_.end(); it != ed; ++it) {
-    if (it->first == name) return true;
-  }
-  return false;
+  float value;
+  return tauID(name, value);
 }
 
 
@@ -357,83 +394,83 @@ void Tau::embedSignalPFCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
+  signalPFCands_.clear();
+  signalPFCandsRefVectorFixed_.reset();
   reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedSignalPFCands_;
   for (unsigned int i = 0; i < candRefVec.size(); i++) {
     signalPFCands_.push_back(*candRefVec.at(i));
   }
   embeddedSignalPFCands_ = true;
+  // the subsets embedded before are now indices into the full vector
+  if (embeddedSignalPFChargedHadrCands_) embedSignalPFChargedHadrCands();
+  if (embeddedSignalPFNeutralHadrCands_) embedSignalPFNeutralHadrCands();
+  if (embeddedSignalPFGammaCands_) embedSignalPFGammaCands();
 }
 void Tau::embedSignalPFChargedHadrCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
-  reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedSignalPFChargedHadrCands_;
-  for (unsigned int i = 0; i < candRefVec.size(); i++) {
-    signalPFChargedHadrCands_.push_back(*candRefVec.at(i));
-  }
-  embeddedSignalPFChargedHadrCands_ = true;
+  embedPFCandSubset(pfSpecific_[0].selectedSignalPFChargedHadrCands_, pfSpecific_[0].selectedSignalPFCands_, embeddedSignalPFCands_,
+                    signalPFCands_, signalPFChargedHadrCands_, signalPFChargedHadrCandIndices_, embeddedSignalPFChargedHadrCands_,
+                    signalPFChargedHadrCandsRefVectorFixed_);
 }
 void Tau::embedSignalPFNeutralHadrCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
-  reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedSignalPFNeutrHadrCands_;
-  for (unsigned int i = 0; i < candRefVec.size(); i++) {
-    signalPFNeutralHadrCands_.push_back(*candRefVec.at(i));
-  }
-  embeddedSignalPFNeutralHadrCands_ = true;
+  embedPFCandSubset(pfSpecific_[0].selectedSignalPFNeutrHadrCands_, pfSpecific_[0].selectedSignalPFCands_, embeddedSignalPFCands_,
+                    signalPFCands_, signalPFNeutralHadrCands_, signalPFNeutralHadrCandIndices_, embeddedSignalPFNeutralHadrCands_,
+                    signalPFNeutralHadrCandsRefVectorFixed_);
 }
 void Tau::embedSignalPFGammaCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
-  reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedSignalPFGammaCands_;
-  for (unsigned int i = 0; i < candRefVec.size(); i++) {
-    signalPFGammaCands_.push_back(*candRefVec.at(i));
-  }
-  embeddedSignalPFGammaCands_ = true;
+  embedPFCandSubset(pfSpecific_[0].selectedSignalPFGammaCands_, pfSpecific_[0].selectedSignalPFCands_, embeddedSignalPFCands_,
+                    signalPFCands_, signalPFGammaCands_, signalPFGammaCandIndices_, embeddedSignalPFGammaCands_,
+                    signalPFGammaCandsRefVectorFixed_);
 }
 
 void Tau::embedIsolationPFCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
+  isolationPFCands_.clear();
+  isolationPFCandsRefVectorFixed_.reset();
   reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedIsolationPFCands_;
   for (unsigned int i = 0; i < candRefVec.size(); i++) {
     isolationPFCands_.push_back(*candRefVec.at(i));
   }
   embeddedIsolationPFCands_ = true;
+  // the subsets embedded before are now indices into the full vector
+  if (embeddedIsolationPFChargedHadrCands_) embedIsolationPFChargedHadrCands();
+  if (embeddedIsolationPFNeutralHadrCands_) embedIsolationPFNeutralHadrCands();
+  if (embeddedIsolationPFGammaCands_) embedIsolationPFGammaCands();
 }
 
 void Tau::embedIsolationPFChargedHadrCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
-  reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedIsolationPFChargedHadrCands_;
-  for (unsigned int i = 0; i < candRefVec.size(); i++) {
-    isolationPFChargedHadrCands_.push_back(*candRefVec.at(i));
-  }
-  embeddedIsolationPFChargedHadrCands_ = true;
+  embedPFCandSubset(pfSpecific_[0].selectedIsolationPFChargedHadrCands_, pfSpecific_[0].selectedIsolationPFCands_, embeddedIsolationPFCands_,
+                    isolationPFCands_, isolationPFChargedHadrCands_, isolationPFChargedHadrCandIndices_, embeddedIsolationPFChargedHadrCands_,
+                    isolationPFChargedHadrCandsRefVectorFixed_);
 }
 void Tau::embedIsolationPFNeutralHadrCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
-  reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedIsolationPFNeutrHadrCands_;
-  for (unsigned int i = 0; i < candRefVec.size(); i++) {
-    isolationPFNeutralHadrCands_.push_back(*candRefVec.at(i));
-  }
-  embeddedIsolationPFNeutralHadrCands_ = true;
+  embedPFCandSubset(pfSpecific_[0].selectedIsolationPFNeutrHadrCands_, pfSpecific_[0].selectedIsolationPFCands_, embeddedIsolationPFCands_,
+                    isolationPFCands_, isolationPFNeutralHadrCands_, isolationPFNeutralHadrCandIndices_, embeddedIsolationPFNeutralHadrCands_,
+                    isolationPFNeutralHadrCandsRefVectorFixed_);
 }
 void Tau::embedIsolationPFGammaCands() {
   if (!isPFTau() ) {//additional check with warning in pat::tau producer
     return;
   }
-  reco::PFCandidateRefVector candRefVec = pfSpecific_[0].selectedIsolationPFGammaCands_;
-  for (unsigned int i = 0; i < candRefVec.size(); i++) {
-    isolationPFGammaCands_.push_back(*candRefVec.at(i));
-  }
-  embeddedIsolationPFGammaCands_ = true;
+  embedPFCandSubset(pfSpecific_[0].selectedIsolationPFGammaCands_, pfSpecific_[0].selectedIsolationPFCands_, embeddedIsolationPFCands_,
+                    isolationPFCands_, isolationPFGammaCands_, isolationPFGammaCandIndices_, embeddedIsolationPFGammaCands_,
+                    isolationPFGammaCandsRefVectorFixed_);
 }
 
 const reco::PFCandidateRef Tau::leadPFChargedHadrCand() const { 
@@ -459,13 +496,17 @@ const reco::PFCandidateRef Tau::leadPFCand() const {
 
 const reco::PFCandidateRefVector & Tau::signalPFCands() const { 
   if (embeddedSignalPFCands_) {
-    if (!signalPFCandsRefVectorFixed_) {
+    if (!signalPFCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
       for (unsigned int i = 0; i < signalPFCands_.size(); i++) {
 	aRefVec.push_back(reco::PFCandidateRef(&signalPFCands_, i) );
       }
-      signalPFCandsTransientRefVector_.swap(aRefVec);
-      signalPFCandsRefVectorFixed_ = true;
+      if (signalPFCandsRefVectorFixed_.tryStartFill()) {
+        signalPFCandsTransientRefVector_.swap(aRefVec);
+        signalPFCandsRefVectorFixed_.publish();
+      } else {
+        signalPFCandsRefVectorFixed_.waitReady();
+      }
     }
     return signalPFCandsTransientRefVector_;
   } else
@@ -474,13 +515,15 @@ const reco::PFCandidateRefVector & Tau::signalPFCands() const {
 
 const reco::PFCandidateRefVector & Tau::signalPFChargedHadrCands() const {
   if (embeddedSignalPFChargedHadrCands_) {
-    if (!signalPFChargedHadrCandsRefVectorFixed_) {
+    if (!signalPFChargedHadrCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
-      for (unsigned int i = 0; i < signalPFChargedHadrCands_.size(); i++) {
-	aRefVec.push_back(reco::PFCandidateRef(&signalPFChargedHadrCands_, i) );
+      fillPFCandSubsetRefs(signalPFChargedHadrCands_, signalPFCands_, signalPFChargedHadrCandIndices_, aRefVec);
+      if (signalPFChargedHadrCandsRefVectorFixed_.tryStartFill()) {
+        signalPFChargedHadrCandsTransientRefVector_.swap(aRefVec);
+        signalPFChargedHadrCandsRefVectorFixed_.publish();
+      } else {
+        signalPFChargedHadrCandsRefVectorFixed_.waitReady();
       }
-      signalPFChargedHadrCandsTransientRefVector_.swap(aRefVec);
-      signalPFChargedHadrCandsRefVectorFixed_ = true;
     }
     return signalPFChargedHadrCandsTransientRefVector_;
   } else
@@ -489,13 +532,15 @@ const reco::PFCandidateRefVector & Tau::signalPFChargedHadrCands() const {
 
 const reco::PFCandidateRefVector & Tau::signalPFNeutrHadrCands() const {
   if (embeddedSignalPFNeutralHadrCands_) {
-    if (!signalPFNeutralHadrCandsRefVectorFixed_) {
+    if (!signalPFNeutralHadrCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
-      for (unsigned int i = 0; i < signalPFNeutralHadrCands_.size(); i++) {
-	aRefVec.push_back(reco::PFCandidateRef(&signalPFNeutralHadrCands_, i) );
+      fillPFCandSubsetRefs(signalPFNeutralHadrCands_, signalPFCands_, signalPFNeutralHadrCandIndices_, aRefVec);
+      if (signalPFNeutralHadrCandsRefVectorFixed_.tryStartFill()) {
+        signalPFNeutralHadrCandsTransientRefVector_.swap(aRefVec);
+        signalPFNeutralHadrCandsRefVectorFixed_.publish();
+      } else {
+        signalPFNeutralHadrCandsRefVectorFixed_.waitReady();
       }
-      signalPFNeutralHadrCandsTransientRefVector_.swap(aRefVec);
-      signalPFNeutralHadrCandsRefVectorFixed_ = true;
     }
     return signalPFNeutralHadrCandsTransientRefVector_;
   } else
@@ -504,13 +549,15 @@ const reco::PFCandidateRefVector & Tau::signalPFNeutrHadrCands() const {
 
 const reco::PFCandidateRefVector & Tau::signalPFGammaCands() const {
   if (embeddedSignalPFGammaCands_) {
-    if (!signalPFGammaCandsRefVectorFixed_) {
+    if (!signalPFGammaCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
-      for (unsigned int i = 0; i < signalPFGammaCands_.size(); i++) {
-	aRefVec.push_back(reco::PFCandidateRef(&signalPFGammaCands_, i) );
+      fillPFCandSubsetRefs(signalPFGammaCands_, signalPFCands_, signalPFGammaCandIndices_, aRefVec);
+      if (signalPFGammaCandsRefVectorFixed_.tryStartFill()) {
+        signalPFGammaCandsTransientRefVector_.swap(aRefVec);
+        signalPFGammaCandsRefVectorFixed_.publish();
+      } else {
+        signalPFGammaCandsRefVectorFixed_.waitReady();
       }
-      signalPFGammaCandsTransientRefVector_.swap(aRefVec);
-      signalPFGammaCandsRefVectorFixed_ = true;
     }
     return signalPFGammaCandsTransientRefVector_;
   } else
@@ -523,13 +570,17 @@ const std::vector<reco::RecoTauPiZero> & Tau::signalPiZeroCandidates() const {
 
 const reco::PFCandidateRefVector & Tau::isolationPFCands() const {
   if (embeddedIsolationPFCands_) {
-    if (!isolationPFCandsRefVectorFixed_) {
+    if (!isolationPFCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
       for (unsigned int i = 0; i < isolationPFCands_.size(); i++) {
 	aRefVec.push_back(reco::PFCandidateRef(&isolationPFCands_, i) );
       }
-      isolationPFCandsTransientRefVector_.swap(aRefVec);
-      isolationPFCandsRefVectorFixed_ = true;
+      if (isolationPFCandsRefVectorFixed_.tryStartFill()) {
+        isolationPFCandsTransientRefVector_.swap(aRefVec);
+        isolationPFCandsRefVectorFixed_.publish();
+      } else {
+        isolationPFCandsRefVectorFixed_.waitReady();
+      }
     }
     return isolationPFCandsTransientRefVector_;
   } else
@@ -538,13 +589,15 @@ const reco::PFCandidateRefVector & Tau::isolationPFCands() const {
 
 const reco::PFCandidateRefVector & Tau::isolationPFChargedHadrCands() const {
   if (embeddedIsolationPFChargedHadrCands_) {
-    if (!isolationPFChargedHadrCandsRefVectorFixed_) {
+    if (!isolationPFChargedHadrCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
-      for (unsigned int i = 0; i < isolationPFChargedHadrCands_.size(); i++) {
-	aRefVec.push_back(reco::PFCandidateRef(&isolationPFChargedHadrCands_, i) );
+      fillPFCandSubsetRefs(isolationPFChargedHadrCands_, isolationPFCands_, isolationPFChargedHadrCandIndices_, aRefVec);
+      if (isolationPFChargedHadrCandsRefVectorFixed_.tryStartFill()) {
+        isolationPFChargedHadrCandsTransientRefVector_.swap(aRefVec);
+        isolationPFChargedHadrCandsRefVectorFixed_.publish();
+      } else {
+        isolationPFChargedHadrCandsRefVectorFixed_.waitReady();
       }
-      isolationPFChargedHadrCandsTransientRefVector_.swap(aRefVec);
-      isolationPFChargedHadrCandsRefVectorFixed_ = true;
     }
     return isolationPFChargedHadrCandsTransientRefVector_;
   } else
@@ -553,13 +606,15 @@ const reco::PFCandidateRefVector & Tau::isolationPFChargedHadrCands() const {
 
 const reco::PFCandidateRefVector & Tau::isolationPFNeutrHadrCands() const {
   if (embeddedIsolationPFNeutralHadrCands_) {
-    if (!isolationPFNeutralHadrCandsRefVectorFixed_) {
+    if (!isolationPFNeutralHadrCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
-      for (unsigned int i = 0; i < isolationPFNeutralHadrCands_.size(); i++) {
-	aRefVec.push_back(reco::PFCandidateRef(&isolationPFNeutralHadrCands_, i) );
+      fillPFCandSubsetRefs(isolationPFNeutralHadrCands_, isolationPFCands_, isolationPFNeutralHadrCandIndices_, aRefVec);
+      if (isolationPFNeutralHadrCandsRefVectorFixed_.tryStartFill()) {
+        isolationPFNeutralHadrCandsTransientRefVector_.swap(aRefVec);
+        isolationPFNeutralHadrCandsRefVectorFixed_.publish();
+      } else {
+        isolationPFNeutralHadrCandsRefVectorFixed_.waitReady();
       }
-      isolationPFNeutralHadrCandsTransientRefVector_.swap(aRefVec);
-      isolationPFNeutralHadrCandsRefVectorFixed_ = true;
     }
     return isolationPFNeutralHadrCandsTransientRefVector_;
   } else
@@ -568,13 +623,15 @@ const reco::PFCandidateRefVector & Tau::isolationPFNeutrHadrCands() const {
 
 const reco::PFCandidateRefVector & Tau::isolationPFGammaCands() const {
   if (embeddedIsolationPFGammaCands_) {
-    if (!isolationPFGammaCandsRefVectorFixed_) {
+    if (!isolationPFGammaCandsRefVectorFixed_.isReady()) {
       reco::PFCandidateRefVector aRefVec;
-      for (unsigned int i = 0; i < isolationPFGammaCands_.size(); i++) {
-	aRefVec.push_back(reco::PFCandidateRef(&isolationPFGammaCands_, i) );
+      fillPFCandSubsetRefs(isolationPFGammaCands_, isolationPFCands_, isolationPFGammaCandIndices_, aRefVec);
+      if (isolationPFGammaCandsRefVectorFixed_.tryStartFill()) {
+        isolationPFGammaCandsTransientRefVector_.swap(aRefVec);
+        isolationPFGammaCandsRefVectorFixed_.publish();
+      } else {
+        isolationPFGammaCandsRefVectorFixed_.waitReady();
       }
-      isolationPFGammaCandsTransientRefVector_.swap(aRefVec);
-      isolationPFGammaCandsRefVectorFixed_ = true;
     }
     return isolationPFGammaCandsTransientRefVector_;
   } else
@@ -585,6 +642,46 @@ const std::vector<reco::RecoTauPiZero> & Tau::isolationPiZeroCandidates() const
   return pfSpecific().isolationPiZeroCandidates_;
 }
 
+TauPFCandidateView Tau::signalPFCandsView() const {
+  if (embeddedSignalPFCands_) return TauPFCandidateView(signalPFCands_);
+  return TauPFCandidateView(pfSpecific().selectedSignalPFCands_);
+}
+
+TauPFCandidateView Tau::signalPFChargedHadrCandsView() const {
+  if (embeddedSignalPFChargedHadrCands_) return pfCandSubsetView(signalPFChargedHadrCands_, signalPFCands_, signalPFChargedHadrCandIndices_);
+  return TauPFCandidateView(pfSpecific().selectedSignalPFChargedHadrCands_);
+}
+
+TauPFCandidateView Tau::signalPFNeutrHadrCandsView() const {
+  if (embeddedSignalPFNeutralHadrCands_) return pfCandSubsetView(signalPFNeutralHadrCands_, signalPFCands_, signalPFNeutralHadrCandIndices_);
+  return TauPFCandidateView(pfSpecific().selectedSignalPFNeutrHadrCands_);
+}
+
+TauPFCandidateView Tau::signalPFGammaCandsView() const {
+  if (embeddedSignalPFGammaCands_) return pfCandSubsetView(signalPFGammaCands_, signalPFCands_, signalPFGammaCandIndices_);
+  return TauPFCandidateView(pfSpecific().selectedSignalPFGammaCands_);
+}
+
+TauPFCandidateView Tau::isolationPFCandsView() const {
+  if (embeddedIsolationPFCands_) return TauPFCandidateView(isolationPFCands_);
+  return TauPFCandidateView(pfSpecific().selectedIsolationPFCands_);
+}
+
+TauPFCandidateView Tau::isolationPFChargedHadrCandsView() const {
+  if (embeddedIsolationPFChargedHadrCands_) return pfCandSubsetView(isolationPFChargedHadrCands_, isolationPFCands_, isolationPFChargedHadrCandIndices_);
+  return TauPFCandidateView(pfSpecific().selectedIsolationPFChargedHadrCands_);
+}
+
+TauPFCandidateView Tau::isolationPFNeutrHadrCandsView() const {
+  if (embeddedIsolationPFNeutralHadrCands_) return pfCandSubsetView(isolationPFNeutralHadrCands_, isolationPFCands_, isolationPFNeutralHadrCandIndices_);
+  return TauPFCandidateView(pfSpecific().selectedIsolationPFNeutrHadrCands_);
+}
+
+TauPFCandidateView Tau::isolationPFGammaCandsView() const {
+  if (embeddedIsolationPFGammaCands_) return pfCandSubsetView(isolationPFGammaCands_, isolationPFCands_, isolationPFGammaCandIndices_);
+  return TauPFCandidateView(pfSpecific().selectedIsolationPFGammaCands_);
+}
+
 /// ============= -Tau-jet Energy Correction methods ============
 /// (copied from DataFormats/PatCandidates/src/Jet.cc)
 
@@ -686,3 +783,44 @@ Tau Tau::correctedTauJet(const unsigned int& level, const unsigned int& set) con
   return correctedTauJet;
 }
 
+/// memory footprint
+void Tau::fillMemoryFootprint(pat::MemoryFootprint & report) const {
+  Lepton<reco::BaseTau>::fillMemoryFootprint(report);
+  report.setObjectSize(sizeof(Tau));
+  report.addContainer("embedded tracks", isolationTracks_);
+  report.addContainer("embedded tracks", leadTrack_);
+  report.addContainer("embedded tracks", signalTracks_);
+  report.addContainer("PF candidates", leadPFCand_);
+  report.addContainer("PF candidates", leadPFChargedHadrCand_);
+  report.addContainer("PF candidates", leadPFNeutralCand_);
+  report.addContainer("PF candidates", signalPFCands_);
+  report.addContainer("PF candidates", signalPFChargedHadrCands_);
+  report.addContainer("PF candidates", signalPFChargedHadrCandIndices_);
+  report.addContainer("PF candidates", signalPFNeutralHadrCands_);
+  report.addContainer("PF candidates", signalPFNeutralHadrCandIndices_);
+  report.addContainer("PF candidates", signalPFGammaCands_);
+  report.addContainer("PF candidates", signalPFGammaCandIndices_);
+  report.addContainer("PF candidates", isolationPFCands_);
+  report.addContainer("PF candidates", isolationPFChargedHadrCands_);
+  report.addContainer("PF candidates", isolationPFChargedHadrCandIndices_);
+  report.addContainer("PF candidates", isolationPFNeutralHadrCands_);
+  report.addContainer("PF candidates", isolationPFNeutralHadrCandIndices_);
+  report.addContainer("PF candidates", isolationPFGammaCands_);
+  report.addContainer("PF candidates", isolationPFGammaCandIndices_);
+  report.addItems("transient refs", isolationTracksTransientRefVector_);
+  report.addItems("transient refs", signalTracksTransientRefVector_);
+  report.addItems("transient refs", signalPFCandsTransientRefVector_);
+  report.addItems("transient refs", signalPFChargedHadrCandsTransientRefVector_);
+  report.addItems("transient refs", signalPFNeutralHadrCandsTransientRefVector_);
+  report.addItems("transient refs", signalPFGammaCandsTransientRefVector_);
+  report.addItems("transient refs", isolationPFCandsTransientRefVector_);
+  report.addItems("transient refs", isolationPFChargedHadrCandsTransientRefVector_);
+  report.addItems("transient refs", isolationPFNeutralHadrCandsTransientRefVector_);
+  report.addItems("transient refs", isolationPFGammaCandsTransientRefVector_);
+  report.addContainer("gen jet", genJet_);
+  report.addContainer("IDs", tauIDs_);
+  report.addContainer("IDs", tauIDStore_.floats());
+  report.addContainer("specific", caloSpecific_);
+  report.addContainer("specific", pfSpecific_);
+  report.addContainer("jet corrections", jec_);
+}
@@ -18,6 +18,12 @@
 #include "DataFormats/PatCandidates/interface/GenericParticle.h"
 #include "DataFormats/PatCandidates/interface/Hemisphere.h"
 #include "DataFormats/PatCandidates/interface/Conversion.h"
+#include "DataFormats/PatCandidates/interface/PackedGenParticle.h"
+#include "DataFormats/PatCandidates/interface/JetKinematicsOverlay.h"
+#include "DataFormats/PatCandidates/interface/DiscriminatorSchema.h"
+#include "DataFormats/PatCandidates/interface/IdStore.h"
+#include "DataFormats/PatCandidates/interface/ConstituentArrays.h"
+#include "DataFormats/PatCandidates/interface/PackedPFCandidate.h"
 
 #include "DataFormats/PatCandidates/interface/StringMap.h"
 #include "DataFormats/PatCandidates/interface/EventHypothesis.h"
@@ -29,6 +35,8 @@
 
 #include "DataFormats/PatCandidates/interface/LookupTableRecord.h"
 
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
+
 #include "DataFormats/METReco/interface/MET.h"
 #include "DataFormats/METReco/interface/METCollection.h"
 #include "DataFormats/METReco/interface/CaloMET.h"
@@ -83,6 +91,34 @@ namespace {
   edm::Wrapper<std::vector<pat::Hemisphere> >	    w_v_p_h;
   edm::Wrapper<std::vector<pat::Conversion> >       w_v_p_c;
 
+  /*   PAT compact generator level particle pool   */
+  std::vector<pat::PackedGenParticle>                   v_p_pgp;
+  edm::Wrapper<std::vector<pat::PackedGenParticle> >    w_v_p_pgp;
+  pat::PackedGenParticleRef                             p_r_pgp_pool;
+  pat::PackedGenParticleRefVector                       p_rv_pgp_pool;
+  pat::PackedGenParticleRefProd                         p_rp_pgp_pool;
+
+  /*   PAT jet kinematics overlay for energy scale variations   */
+  edm::Wrapper<pat::JetKinematicsOverlay>               w_p_jko;
+
+  /*   PAT discriminator schema shared by the objects of a collection   */
+  edm::Wrapper<pat::DiscriminatorSchema>                w_p_ds;
+  pat::DiscriminatorSchemaRefProd                       p_rp_ds;
+
+  /*   PAT ID schema shared by the objects of a collection   */
+  edm::Wrapper<pat::IdSchema>                           w_p_ids;
+  pat::IdSchemaRefProd                                  p_rp_ids;
+
+  /*   PAT columnar jet constituents   */
+  edm::Wrapper<pat::ConstituentArrays>                  w_p_ca;
+
+  /*   PAT slimmed PF candidate pool   */
+  std::vector<pat::PackedPFCandidate>                   v_p_ppfc;
+  edm::Wrapper<std::vector<pat::PackedPFCandidate> >    w_v_p_ppfc;
+  pat::PackedPFCandidateRef                             p_r_ppfc_pool;
+  pat::PackedPFCandidateRefVector                       p_rv_ppfc_pool;
+  pat::PackedPFCandidateRefProd                         p_rp_ppfc_pool;
+
   /*   PAT Object References   */
   pat::ElectronRef	    p_r_e;
   pat::MuonRef	            p_r_mu;
@@ -314,6 +350,7 @@ namespace {
   std::vector<pat::CandKinResolution>  v_ckr;
   pat::CandKinResolutionValueMap vm_ckr;
   edm::Wrapper<pat::CandKinResolutionValueMap> w_vm_ckr;
+  edm::Wrapper<pat::FloatPrecisionPolicy> w_p_fpp;
   edm::Ptr<pat::Jet> ptr_Jet;
   edm::Ptr<pat::MET> ptr_MET;
   edm::Ptr<pat::Electron> ptr_Electron;
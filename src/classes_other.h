@@ -17,6 +17,8 @@
 
 #include "DataFormats/PatCandidates/interface/CandKinResolution.h"
 
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
+
 namespace {
   struct dictionary {
 
@@ -50,6 +52,7 @@ namespace {
   std::vector<pat::CandKinResolution>  v_ckr;
   pat::CandKinResolutionValueMap vm_ckr;
   edm::Wrapper<pat::CandKinResolutionValueMap> w_vm_ckr;
+  edm::Wrapper<pat::FloatPrecisionPolicy> w_p_fpp;
 
   };
 
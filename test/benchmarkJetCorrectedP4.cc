@@ -0,0 +1,117 @@
+// Compare the cost of the corrected four-momentum of a pat::Jet computed from a corrected copy
+// of the jet (correctedJet(...).p4(), as correctedP4 did before) with the one computed directly
+// from the correction factors (correctedP4), by label, by pat::JecHandle and by index.
+//
+// usage: benchmarkJetCorrectedP4 [number of jets] [number of passes]
+
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "DataFormats/JetReco/interface/PFJet.h"
+
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace {
+  /// sets the correction factors through the protected members, as PATJetProducer does
+  /// through the private addJECFactors and initializeJEC
+  class CorrectedJet : public pat::Jet {
+    public:
+      explicit CorrectedJet(const reco::Jet & jet) : pat::Jet(jet) {}
+      void setJEC(const pat::JetCorrFactors & jec, unsigned int level) {
+        jec_.push_back(jec);
+        currentJECSet_ = 0;
+        currentJECLevel_ = level;
+        currentJECFlavor_ = pat::JetCorrFactors::NONE;
+        setP4(jec.correction(level)*p4());
+      }
+  };
+
+  std::vector<pat::Jet> makeJets(unsigned int nJets) {
+    std::vector<pat::Jet> jets;
+    jets.reserve(nJets);
+    for (unsigned int i = 0; i < nJets; ++i) {
+      double pt = 20. + (i % 100), eta = -2.5 + 0.05*(i % 100), phi = -3. + 0.06*(i % 100);
+      reco::Particle::PolarLorentzVector p4(pt, eta, phi, 5.);
+      reco::PFJet pfJet(reco::Particle::LorentzVector(p4), reco::Particle::Point(0,0,0), reco::PFJet::Specific());
+      CorrectedJet jet(pfJet);
+      // some payload, so that copying the jet costs what it costs in a real pat tuple
+      for (unsigned int u = 0; u < 10; ++u) {
+        std::ostringstream label; label << "userFloat" << u;
+        jet.addUserFloat(label.str(), u);
+      }
+      std::vector<pat::JetCorrFactors::CorrectionFactor> factors;
+      factors.push_back(pat::JetCorrFactors::CorrectionFactor("Uncorrected", std::vector<float>(1, 1.)));
+      factors.push_back(pat::JetCorrFactors::CorrectionFactor("L1Offset",    std::vector<float>(1, 0.95)));
+      factors.push_back(pat::JetCorrFactors::CorrectionFactor("L2Relative",  std::vector<float>(1, 1.10)));
+      factors.push_back(pat::JetCorrFactors::CorrectionFactor("L3Absolute",  std::vector<float>(1, 1.05)));
+      pat::JetCorrFactors jec("patJetCorrFactors", factors);
+      jet.setJEC(jec, jec.jecLevel("L3Absolute"));
+      jets.push_back(jet);
+    }
+    return jets;
+  }
+
+  double seconds(clock_t start) { return double(clock() - start)/CLOCKS_PER_SEC; }
+}
+
+int main(int argc, char **argv) {
+  unsigned int nJets   = (argc > 1 ? std::atoi(argv[1]) : 1000);
+  unsigned int nPasses = (argc > 2 ? std::atoi(argv[2]) : 100);
+  std::vector<pat::Jet> jets = makeJets(nJets);
+  const char * levels[] = { "Uncorrected", "L1Offset", "L2Relative", "L3Absolute" };
+  const unsigned int nLevels = sizeof(levels)/sizeof(levels[0]);
+  const double nCalls = double(nJets)*nPasses*nLevels;
+
+  std::vector<pat::JecHandle> handles;
+  for (unsigned int level = 0; level < nLevels; ++level) handles.push_back(pat::JecHandle(levels[level]));
+
+  double sumCopy = 0, sumDirect = 0, sumHandle = 0, sumIndex = 0;
+  clock_t start = clock();
+  for (unsigned int pass = 0; pass < nPasses; ++pass) {
+    for (std::vector<pat::Jet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet) {
+      for (unsigned int level = 0; level < nLevels; ++level) sumCopy += jet->correctedJet(levels[level]).p4().pt();
+    }
+  }
+  double tCopy = seconds(start);
+
+  start = clock();
+  for (unsigned int pass = 0; pass < nPasses; ++pass) {
+    for (std::vector<pat::Jet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet) {
+      for (unsigned int level = 0; level < nLevels; ++level) sumDirect += jet->correctedP4(levels[level]).pt();
+    }
+  }
+  double tDirect = seconds(start);
+
+  start = clock();
+  for (unsigned int pass = 0; pass < nPasses; ++pass) {
+    for (std::vector<pat::Jet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet) {
+      for (unsigned int level = 0; level < nLevels; ++level) sumHandle += jet->correctedPt(handles[level]);
+    }
+  }
+  double tHandle = seconds(start);
+
+  start = clock();
+  for (unsigned int pass = 0; pass < nPasses; ++pass) {
+    for (std::vector<pat::Jet>::const_iterator jet = jets.begin(); jet != jets.end(); ++jet) {
+      for (unsigned int level = 0; level < nLevels; ++level) sumIndex += jet->correctedPt(level);
+    }
+  }
+  double tIndex = seconds(start);
+
+  std::cout << "corrected pt of " << nJets << " jets, " << nLevels << " levels, " << nPasses << " passes" << std::endl;
+  std::cout << std::setw(36) << std::left << "correctedJet(label).p4()" << std::right << std::setw(10) << std::fixed << std::setprecision(1) << 1.e9*tCopy/nCalls   << " ns/call" << std::endl;
+  std::cout << std::setw(36) << std::left << "correctedP4(label)"       << std::right << std::setw(10) << std::fixed << std::setprecision(1) << 1.e9*tDirect/nCalls << " ns/call" << std::endl;
+  std::cout << std::setw(36) << std::left << "correctedPt(handle)"      << std::right << std::setw(10) << std::fixed << std::setprecision(1) << 1.e9*tHandle/nCalls << " ns/call" << std::endl;
+  std::cout << std::setw(36) << std::left << "correctedPt(index)"       << std::right << std::setw(10) << std::fixed << std::setprecision(1) << 1.e9*tIndex/nCalls  << " ns/call" << std::endl;
+
+  if (std::abs(sumCopy - sumDirect) > 1.e-6*std::abs(sumCopy) || std::abs(sumCopy - sumHandle) > 1.e-6*std::abs(sumCopy) ||
+      std::abs(sumCopy - sumIndex) > 1.e-6*std::abs(sumCopy)) {
+    std::cout << "ERROR: the corrected pt differ: " << sumCopy << " " << sumDirect << " " << sumHandle << " " << sumIndex << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,184 @@
+// Report, for each floating point payload of the PAT objects to which pat::FloatPrecisionPolicy
+// applies, the compressed size and the largest relative error of the values read from a sample
+// of events when they are rounded to fewer mantissa bits, so that the precision of each member
+// can be chosen by trading it against the output size.
+//
+// The values of each member are gathered over the sample into one array, which is compressed
+// with zlib at the default compression level of ROOT; this is close to what happens to the
+// member in the ROOT baskets, since its values are written next to each other.
+//
+// usage: reportFloatPrecision file.root [number of events] [jets] [electrons] [muons] [taus]
+//        (default labels: selectedPatJets selectedPatElectrons selectedPatMuons selectedPatTaus)
+
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/PatCandidates/interface/Tau.h"
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
+#include "DataFormats/FWLite/interface/Event.h"
+#include "DataFormats/FWLite/interface/Handle.h"
+#include "FWCore/FWLite/interface/AutoLibraryLoader.h"
+
+#include "TFile.h"
+#include "TSystem.h"
+
+#include <zlib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+  typedef std::vector<std::vector<float> > Samples;
+
+  // values which are not set are returned as -1 (isolations) or as the largest double (impact parameters)
+  void addValue(std::vector<float> & sample, double value) {
+    if (value < 0.1*std::numeric_limits<float>::max()) sample.push_back(value);
+  }
+
+  template <typename T>
+  void addObject(Samples & samples, const pat::PATObject<T> & object) {
+    const std::vector<std::string> & names = object.userFloatNames();
+    for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+      samples[pat::FloatPrecisionPolicy::UserFloats].push_back(object.userFloat(*it));
+    }
+    if (object.hasKinResolution()) {
+      const AlgebraicSymMatrix44 & covariance = object.getKinResolution().covariance();
+      for (AlgebraicSymMatrix44::const_iterator it = covariance.begin(); it != covariance.end(); ++it) {
+        samples[pat::FloatPrecisionPolicy::KinResolutions].push_back(*it);
+      }
+    }
+  }
+
+  template <typename T>
+  void addLepton(Samples & samples, const pat::Lepton<T> & lepton) {
+    addObject(samples, lepton);
+    for (int key = pat::TrackIso; key <= pat::PfChargedAllIso; ++key) {
+      float value = lepton.isolation(pat::IsolationKeys(key));
+      if (value != -1.0) samples[pat::FloatPrecisionPolicy::Isolations].push_back(value);
+    }
+  }
+
+  template <typename T>
+  void addImpactParameters(Samples & samples, const T & lepton) {
+    for (int type = T::None; type <= T::BS3D; ++type) {
+      addValue(samples[pat::FloatPrecisionPolicy::ImpactParameters], lepton.dB(typename T::IpType(type)));
+      addValue(samples[pat::FloatPrecisionPolicy::ImpactParameters], lepton.edB(typename T::IpType(type)));
+    }
+  }
+
+  void addJet(Samples & samples, const pat::Jet & jet) {
+    addObject(samples, jet);
+    const std::vector<std::pair<std::string, float> > & discriminators = jet.getPairDiscri();
+    for (std::vector<std::pair<std::string, float> >::const_iterator it = discriminators.begin(); it != discriminators.end(); ++it) {
+      samples[pat::FloatPrecisionPolicy::BDiscriminators].push_back(it->second);
+    }
+    // the stored factors, as rounded by the policy; jecFactor would need a flavor for the flavor dependent levels
+    for (unsigned int set = 0; jet.jecSetAvailable(set); ++set) {
+      const pat::JetCorrFactors & factors = jet.jecCorrFactors(set);
+      for (unsigned int level = 0; level < factors.numberOfCorrectionLevels(); ++level) {
+        const std::vector<float> & values = factors.correctionFactors(level);
+        samples[pat::FloatPrecisionPolicy::JecFactors].insert(samples[pat::FloatPrecisionPolicy::JecFactors].end(), values.begin(), values.end());
+      }
+    }
+  }
+
+  template <typename T>
+  bool getCollection(const fwlite::Event & event, fwlite::Handle<std::vector<T> > & handle, const std::string & label) {
+    try {
+      handle.getByLabel(event, label.c_str());
+      return handle.isValid();
+    } catch (cms::Exception &) {
+      return false;
+    }
+  }
+
+  uLong compressedSize(const std::vector<float> & values) {
+    if (values.empty()) return 0;
+    uLong size = values.size()*sizeof(float);
+    std::vector<Bytef> buffer(compressBound(size));
+    uLongf compressed = buffer.size();
+    if (compress2(&buffer[0], &compressed, reinterpret_cast<const Bytef *>(&values[0]), size, 1) != Z_OK) return size;
+    return compressed;
+  }
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " file.root [number of events] [jets] [electrons] [muons] [taus]" << std::endl;
+    return 1;
+  }
+  gSystem->Load("libFWCoreFWLite");
+  AutoLibraryLoader::enable();
+
+  TFile * file = TFile::Open(argv[1]);
+  if (file == 0) {
+    std::cerr << "cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+  long maxEvents = (argc > 2 ? std::atol(argv[2]) : -1);
+  std::string jetLabel      = (argc > 3 ? argv[3] : "selectedPatJets");
+  std::string electronLabel = (argc > 4 ? argv[4] : "selectedPatElectrons");
+  std::string muonLabel     = (argc > 5 ? argv[5] : "selectedPatMuons");
+  std::string tauLabel      = (argc > 6 ? argv[6] : "selectedPatTaus");
+
+  Samples samples(pat::FloatPrecisionPolicy::NumberOfMembers);
+  long nEvents = 0;
+  fwlite::Event event(file);
+  for (event.toBegin(); !event.atEnd() && (maxEvents < 0 || nEvents < maxEvents); ++event, ++nEvents) {
+    fwlite::Handle<std::vector<pat::Jet> > jets;
+    if (getCollection(event, jets, jetLabel)) {
+      for (std::vector<pat::Jet>::const_iterator it = jets->begin(); it != jets->end(); ++it) addJet(samples, *it);
+    }
+    fwlite::Handle<std::vector<pat::Electron> > electrons;
+    if (getCollection(event, electrons, electronLabel)) {
+      for (std::vector<pat::Electron>::const_iterator it = electrons->begin(); it != electrons->end(); ++it) {
+        addLepton(samples, *it);
+        addImpactParameters(samples, *it);
+      }
+    }
+    fwlite::Handle<std::vector<pat::Muon> > muons;
+    if (getCollection(event, muons, muonLabel)) {
+      for (std::vector<pat::Muon>::const_iterator it = muons->begin(); it != muons->end(); ++it) {
+        addLepton(samples, *it);
+        addImpactParameters(samples, *it);
+      }
+    }
+    fwlite::Handle<std::vector<pat::Tau> > taus;
+    if (getCollection(event, taus, tauLabel)) {
+      for (std::vector<pat::Tau>::const_iterator it = taus->begin(); it != taus->end(); ++it) addLepton(samples, *it);
+    }
+  }
+
+  static const unsigned int bits[] = { pat::FloatPrecisionPolicy::FullPrecision, 16, 14, 12, 10, 8 };
+  static const unsigned int nBits = sizeof(bits)/sizeof(bits[0]);
+  std::cout << "float payloads of " << nEvents << " events; sizes in bytes per event, after zlib compression" << std::endl;
+  std::cout << std::setw(18) << "member" << std::setw(10) << "values" << std::setw(10) << "raw";
+  for (unsigned int b = 0; b < nBits; ++b) std::cout << std::setw(9) << bits[b] << " bits" << std::setw(14) << "max.rel.err";
+  std::cout << std::endl;
+  for (int m = 0; m < pat::FloatPrecisionPolicy::NumberOfMembers; ++m) {
+    const std::vector<float> & values = samples[m];
+    double perEvent = (nEvents > 0 ? 1.0/nEvents : 0.);
+    std::cout << std::setw(18) << pat::FloatPrecisionPolicy::memberName(pat::FloatPrecisionPolicy::Member(m))
+              << std::setw(10) << values.size()
+              << std::setw(10) << std::fixed << std::setprecision(1) << values.size()*sizeof(float)*perEvent;
+    for (unsigned int b = 0; b < nBits; ++b) {
+      std::vector<float> reduced(values);
+      double maxError = 0;
+      for (std::vector<float>::iterator it = reduced.begin(); it != reduced.end(); ++it) {
+        float value = *it;
+        *it = pat::FloatPrecisionPolicy::reduceMantissa(value, bits[b]);
+        if (value != 0) maxError = std::max(maxError, std::abs(double(*it - value)/value));
+      }
+      std::cout << std::setw(14) << std::fixed << std::setprecision(1) << compressedSize(reduced)*perEvent
+                << std::setw(14) << std::scientific << std::setprecision(2) << maxError;
+    }
+    std::cout << std::endl;
+  }
+  file->Close();
+  return 0;
+}
@@ -0,0 +1,129 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+#include "FWCore/Utilities/interface/EDMException.h"
+#include "DataFormats/PatCandidates/interface/FloatPrecisionPolicy.h"
+
+namespace {
+  uint32_t bitsOf(float value) {
+    uint32_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    return word;
+  }
+}
+
+class testFloatPrecisionPolicy : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testFloatPrecisionPolicy);
+
+  CPPUNIT_TEST(testRounding);
+  CPPUNIT_TEST(testErrorBound);
+  CPPUNIT_TEST(testFullPrecision);
+  CPPUNIT_TEST(testSpecialValues);
+  CPPUNIT_TEST(testLargestFinite);
+  CPPUNIT_TEST(testPolicy);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+
+  void testRounding();
+  void testErrorBound();
+  void testFullPrecision();
+  void testSpecialValues();
+  void testLargestFinite();
+  void testPolicy();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testFloatPrecisionPolicy);
+
+using pat::FloatPrecisionPolicy;
+
+void testFloatPrecisionPolicy::testRounding() {
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(1.f, 1) == 1.f);
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(0.f, 5) == 0.f);
+  // to the nearest value, halfway cases away from zero
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(1.f + std::ldexp(1.f, -23), 10) == 1.f);
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(1.25f, 1) == 1.5f);
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(1.2f, 1) == 1.f);
+  // a carry out of the mantissa goes into the exponent
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(1.75f, 1) == 2.f);
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(-1.75f, 1) == -2.f);
+  CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(1.99f, 4) == 2.f);
+}
+
+void testFloatPrecisionPolicy::testErrorBound() {
+  const float values[] = { 3.14159265f, -2.71828183f, 1.e-30f, 6.02214e23f, 0.1f, -123.456f, 1.e-40f };
+  for (unsigned int bits = 1; bits < FloatPrecisionPolicy::FullPrecision; ++bits) {
+    const uint32_t lowBits = (uint32_t(1) << (FloatPrecisionPolicy::FullPrecision - bits)) - 1;
+    for (unsigned int i = 0; i < sizeof(values)/sizeof(values[0]); ++i) {
+      const float reduced = FloatPrecisionPolicy::reduceMantissa(values[i], bits);
+      // the dropped bits are zero, the sign is kept and the error is at most half a unit of the last bit kept
+      CPPUNIT_ASSERT((bitsOf(reduced) & lowBits) == 0);
+      CPPUNIT_ASSERT((reduced < 0) == (values[i] < 0));
+      CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(-values[i], bits) == -reduced);
+      if (std::abs(values[i]) >= FLT_MIN) {
+        CPPUNIT_ASSERT(std::abs(double(reduced) - values[i]) <= std::abs(double(values[i])) * std::ldexp(1., -int(bits) - 1));
+      }
+      // rounding again does nothing
+      CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(reduced, bits) == reduced);
+    }
+  }
+}
+
+void testFloatPrecisionPolicy::testFullPrecision() {
+  const float value = 3.14159265f;
+  CPPUNIT_ASSERT(bitsOf(FloatPrecisionPolicy::reduceMantissa(value, FloatPrecisionPolicy::FullPrecision)) == bitsOf(value));
+  CPPUNIT_ASSERT(bitsOf(FloatPrecisionPolicy::reduceMantissa(value, 30)) == bitsOf(value));
+  CPPUNIT_ASSERT(bitsOf(FloatPrecisionPolicy::reduceMantissa(FLT_MAX, FloatPrecisionPolicy::FullPrecision)) == bitsOf(FLT_MAX));
+}
+
+void testFloatPrecisionPolicy::testSpecialValues() {
+  const float inf = std::numeric_limits<float>::infinity();
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  for (unsigned int bits = 1; bits < FloatPrecisionPolicy::FullPrecision; ++bits) {
+    CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(inf, bits) == inf);
+    CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(-inf, bits) == -inf);
+    CPPUNIT_ASSERT(bitsOf(FloatPrecisionPolicy::reduceMantissa(nan, bits)) == bitsOf(nan));
+  }
+}
+
+void testFloatPrecisionPolicy::testLargestFinite() {
+  for (unsigned int bits = 1; bits < FloatPrecisionPolicy::FullPrecision; ++bits) {
+    const uint32_t lowBits = (uint32_t(1) << (FloatPrecisionPolicy::FullPrecision - bits)) - 1;
+    // the largest finite float rounds up beyond the range; it becomes the largest finite value with these bits
+    const float reduced = FloatPrecisionPolicy::reduceMantissa(FLT_MAX, bits);
+    CPPUNIT_ASSERT(bitsOf(reduced) == (0x7f7fffff & ~lowBits));
+    CPPUNIT_ASSERT(FloatPrecisionPolicy::reduceMantissa(-FLT_MAX, bits) == -reduced);
+  }
+}
+
+void testFloatPrecisionPolicy::testPolicy() {
+  FloatPrecisionPolicy policy;
+  CPPUNIT_ASSERT(policy.isLossless());
+  CPPUNIT_ASSERT(policy.mantissaBits(FloatPrecisionPolicy::JecFactors) == FloatPrecisionPolicy::FullPrecision);
+
+  policy.setMantissaBits("jecFactors", 10);
+  CPPUNIT_ASSERT(!policy.isLossless());
+  CPPUNIT_ASSERT(policy.mantissaBits(FloatPrecisionPolicy::JecFactors) == 10);
+  CPPUNIT_ASSERT(policy.mantissaBits(FloatPrecisionPolicy::UserFloats) == FloatPrecisionPolicy::FullPrecision);
+
+  std::vector<float> values(2, 1.f + std::ldexp(1.f, -20));
+  policy.reduce(FloatPrecisionPolicy::UserFloats, values);
+  CPPUNIT_ASSERT(values[0] == 1.f + std::ldexp(1.f, -20));
+  policy.reduce(FloatPrecisionPolicy::JecFactors, values);
+  CPPUNIT_ASSERT(values[0] == 1.f && values[1] == 1.f);
+  const double precise = 1. + std::ldexp(1., -40);
+  CPPUNIT_ASSERT(policy.reduce(FloatPrecisionPolicy::UserFloats, precise) == precise);
+  CPPUNIT_ASSERT(policy.reduce(FloatPrecisionPolicy::JecFactors, precise) == 1.);
+
+  CPPUNIT_ASSERT_THROW(policy.setMantissaBits(FloatPrecisionPolicy::Isolations, 0), cms::Exception);
+  CPPUNIT_ASSERT_THROW(policy.setMantissaBits(FloatPrecisionPolicy::Isolations, 24), cms::Exception);
+  CPPUNIT_ASSERT_THROW(policy.setMantissaBits("noSuchMember", 10), cms::Exception);
+  CPPUNIT_ASSERT(policy.mantissaBits(FloatPrecisionPolicy::Isolations) == FloatPrecisionPolicy::FullPrecision);
+}
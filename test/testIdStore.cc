@@ -0,0 +1,355 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/PatCandidates/interface/IdStore.h"
+#include "DataFormats/Common/interface/RefCore.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+
+namespace {
+  /// object storing its IDs either in an IdStore or as pairs, as pat::Electron
+  class IdObject {
+    public:
+      typedef pat::IdPairs<float> Ids;
+      const pat::IdStore & idStore() const { return store; }
+      bool passIds(pat::IdMask & mask) const { return Ids::passes(store, pairs, mask); }
+      pat::IdStore store;
+      Ids::Pairs   pairs;
+  };
+
+  /// schema with a float ID, two boolean ones and one detected from its values
+  void fillSchema(pat::IdSchema & schema) {
+    schema.add("mva", pat::IdSchema::Float);
+    schema.add("loose", pat::IdSchema::Boolean);
+    schema.add("tight", pat::IdSchema::Boolean);
+    std::vector<float> values(3, 1.f);
+    values[1] = 0.f;
+    schema.addDetected("veto", values);
+  }
+}
+
+class testIdStore : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testIdStore);
+
+  CPPUNIT_TEST(testSchema);
+  CPPUNIT_TEST(testSetGet);
+  CPPUNIT_TEST(testSchemaContent);
+  CPPUNIT_TEST(testPairs);
+  CPPUNIT_TEST(testMigratePairs);
+  CPPUNIT_TEST(testDroppedSchema);
+  CPPUNIT_TEST(testMask);
+  CPPUNIT_TEST(testMaskSchemaChange);
+  CPPUNIT_TEST(testPassAll);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+
+  void testSchema();
+  void testSetGet();
+  void testSchemaContent();
+  void testPairs();
+  void testMigratePairs();
+  void testDroppedSchema();
+  void testMask();
+  void testMaskSchemaChange();
+  void testPassAll();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testIdStore);
+
+void testIdStore::testSchema() {
+  pat::IdSchema schema;
+  fillSchema(schema);
+  CPPUNIT_ASSERT(schema.size() == 4);
+  CPPUNIT_ASSERT(schema.add("loose", pat::IdSchema::Float) == 1);
+  CPPUNIT_ASSERT(schema.size() == 4);
+  CPPUNIT_ASSERT(schema.index("tight") == 2 && schema.index("medium") == -1);
+  CPPUNIT_ASSERT(schema.kind(0) == pat::IdSchema::Float && schema.position(0) == 0);
+  CPPUNIT_ASSERT(schema.kind(2) == pat::IdSchema::Boolean && schema.position(2) == 1);
+  CPPUNIT_ASSERT(schema.kind(3) == pat::IdSchema::Boolean && schema.position(3) == 2);
+  CPPUNIT_ASSERT(schema.nFloats() == 1 && schema.nBooleans() == 3);
+
+  std::vector<float> values(2, 0.f);
+  values[1] = 0.7f;
+  CPPUNIT_ASSERT(!pat::IdSchema::isBoolean(values));
+  CPPUNIT_ASSERT(schema.kind(schema.addDetected("mva2", values)) == pat::IdSchema::Float);
+
+  // the booleans beyond the word go to the float column
+  pat::IdSchema many;
+  for (unsigned int i = 0; i <= pat::IdSchema::MaxBooleans; ++i) {
+    std::ostringstream name;
+    name << "wp" << i;
+    many.add(name.str(), pat::IdSchema::Boolean);
+  }
+  CPPUNIT_ASSERT(many.nBooleans() == pat::IdSchema::MaxBooleans && many.nFloats() == 1);
+  CPPUNIT_ASSERT(many.kind(pat::IdSchema::MaxBooleans) == pat::IdSchema::Float);
+}
+
+void testIdStore::testSetGet() {
+  pat::IdSchema schema;
+  fillSchema(schema);
+  pat::IdStore store;
+  float value = -1.f;
+  CPPUNIT_ASSERT(!store.hasSchema() && store.schema() == 0);
+  CPPUNIT_ASSERT(!store.get("mva", value));
+  CPPUNIT_ASSERT_THROW(store.set(0, 1.f), cms::Exception);
+
+  store.setSchema(pat::IdSchemaRefProd(&schema));
+  CPPUNIT_ASSERT(store.hasSchema() && store.schema() == &schema);
+  for (unsigned int slot = 0; slot < schema.size(); ++slot) CPPUNIT_ASSERT(!store.isSet(slot) && !store.get(slot, value));
+
+  store.set(0, 0.25f);
+  store.set(1, 1.f);
+  store.set(2, 0.f);
+  CPPUNIT_ASSERT(store.isSet(0) && store.isSet(1) && store.isSet(2) && !store.isSet(3));
+  CPPUNIT_ASSERT(store.get(0, value) && value == 0.25f);
+  CPPUNIT_ASSERT(store.get("loose", value) && value == 1.f);
+  // a boolean set to false has a value
+  CPPUNIT_ASSERT(store.get("tight", value) && value == 0.f);
+  CPPUNIT_ASSERT(!store.get("veto", value) && !store.get("medium", value));
+  pat::DiscriminatorHandle handle("mva");
+  CPPUNIT_ASSERT(store.get(handle, value) && value == 0.25f);
+  CPPUNIT_ASSERT(!store.isSet(17));
+  CPPUNIT_ASSERT_THROW(store.set(17, 1.f), cms::Exception);
+
+  CPPUNIT_ASSERT(store.booleans() == 1 && store.booleansSet() == 3);
+  CPPUNIT_ASSERT(store.passes(1) && !store.passes(3) && store.passes(0));
+  CPPUNIT_ASSERT(store.floats().size() == 1 && store.floats()[0] == 0.25f);
+
+  // booleans are true above 0.5, and can be set again
+  store.set(2, 0.6f);
+  CPPUNIT_ASSERT(store.booleans() == 3);
+  store.set(1, 0.4f);
+  CPPUNIT_ASSERT(store.booleans() == 2 && store.booleansSet() == 3);
+
+  std::vector<std::pair<std::string, float> > pairs;
+  store.fillPairs(pairs);
+  CPPUNIT_ASSERT(pairs.size() == 3);
+  CPPUNIT_ASSERT(pairs[0].first == "mva" && pairs[2].first == "tight" && pairs[2].second == 1.f);
+
+  store.clear();
+  CPPUNIT_ASSERT(store.hasSchema() && !store.isSet(0) && !store.isSet(1));
+  CPPUNIT_ASSERT(store.booleans() == 0 && store.booleansSet() == 0 && store.floats().empty());
+}
+
+void testIdStore::testSchemaContent() {
+  pat::IdSchema schema;
+  fillSchema(schema);
+  schema.add("mva2", pat::IdSchema::Float);
+  pat::IdStore store;
+  // in the module producing the schema, the RefProd can not be read yet: the schema is given
+  store.set(4, 0.5f, &schema);
+  store.set(3, 1.f, &schema);
+  CPPUNIT_ASSERT(store.floats().size() == 2);
+  CPPUNIT_ASSERT(store.floats()[0] != store.floats()[0] && store.floats()[1] == 0.5f);
+  CPPUNIT_ASSERT(store.booleans() == 4 && store.booleansSet() == 4);
+  CPPUNIT_ASSERT_THROW(store.set(5, 1.f, &schema), cms::Exception);
+
+  // the values not set are NaN in the float column, and reported as missing
+  pat::IdSchema readBack;
+  fillSchema(readBack);
+  readBack.add("mva2", pat::IdSchema::Float);
+  store.setSchema(pat::IdSchemaRefProd(&readBack));
+  store.set(4, 0.5f);
+  float value;
+  CPPUNIT_ASSERT(!store.get("mva", value));
+  CPPUNIT_ASSERT(store.get("mva2", value) && value == 0.5f);
+}
+
+void testIdStore::testPairs() {
+  typedef pat::IdPairs<float> Ids;
+  Ids ids;
+  pat::IdStore store;
+  Ids::Pairs pairs, input;
+  input.push_back(Ids::Pair("mva", 0.25f));
+  input.push_back(Ids::Pair("loose", 1.f));
+
+  // without schema, the IDs are kept as pairs
+  ids.set(store, pairs, input, 0, "test");
+  CPPUNIT_ASSERT(pairs.size() == 2 && !store.hasSchema());
+  float value;
+  CPPUNIT_ASSERT(Ids::get(store, pairs, "mva", value) && value == 0.25f);
+  CPPUNIT_ASSERT(!Ids::get(store, pairs, "tight", value));
+  pat::DiscriminatorHandle handle("loose");
+  CPPUNIT_ASSERT(Ids::get(store, pairs, handle, value) && value == 1.f);
+  CPPUNIT_ASSERT(&ids.all(store, pairs) == &pairs);
+  CPPUNIT_ASSERT(ids.get(store, pairs, "loose", "test") == 1.f);
+  CPPUNIT_ASSERT_THROW(ids.get(store, pairs, "tight", "test"), cms::Exception);
+
+  // with a schema, they go to the store
+  pat::IdSchema schema;
+  fillSchema(schema);
+  Ids::Pairs noPairs;
+  store.setSchema(pat::IdSchemaRefProd(&schema));
+  ids.set(store, noPairs, input, 0, "test");
+  CPPUNIT_ASSERT(noPairs.empty());
+  CPPUNIT_ASSERT(Ids::get(store, noPairs, "mva", value) && value == 0.25f);
+  CPPUNIT_ASSERT(Ids::get(store, noPairs, handle, value) && value == 1.f);
+  CPPUNIT_ASSERT(ids.all(store, noPairs).size() == 2);
+  // the pairs built from the store follow the changes
+  ids.set(store, schema.index("tight"), 1.f, 0);
+  CPPUNIT_ASSERT(ids.all(store, noPairs).size() == 3);
+
+  input.push_back(Ids::Pair("medium", 1.f));
+  CPPUNIT_ASSERT_THROW(ids.set(store, noPairs, input, 0, "test"), cms::Exception);
+}
+
+void testIdStore::testMigratePairs() {
+  // IDs read as pairs from an old file, moved into a store with a schema
+  typedef pat::IdPairs<bool> Ids;
+  Ids ids;
+  pat::IdStore store;
+  Ids::Pairs pairs;
+  pairs.push_back(Ids::Pair("loose", true));
+  pairs.push_back(Ids::Pair("tight", false));
+
+  pat::IdSchema schema;
+  fillSchema(schema);
+  ids.setSchema(store, pairs, pat::IdSchemaRefProd(&schema), 0, "test");
+  CPPUNIT_ASSERT(pairs.empty() && store.hasSchema());
+  CPPUNIT_ASSERT(store.booleansSet() == 3 && store.booleans() == 1);
+  bool value = false;
+  CPPUNIT_ASSERT(Ids::get(store, pairs, "loose", value) && value);
+  CPPUNIT_ASSERT(Ids::get(store, pairs, "tight", value) && !value);
+  CPPUNIT_ASSERT(!Ids::get(store, pairs, "mva", value));
+  const Ids::Pairs & all = ids.all(store, pairs);
+  CPPUNIT_ASSERT(all.size() == 2 && all[0].first == "loose" && all[0].second);
+
+  // an ID missing from the schema is an error
+  Ids::Pairs other;
+  other.push_back(Ids::Pair("medium", true));
+  pat::IdStore otherStore;
+  CPPUNIT_ASSERT_THROW(ids.setSchema(otherStore, other, pat::IdSchemaRefProd(&schema), 0, "test"), cms::Exception);
+}
+
+void testIdStore::testDroppedSchema() {
+  // a RefProd to a schema product which is not in the event, as when the schema was not kept
+  typedef pat::IdPairs<float> Ids;
+  pat::IdSchema schema;
+  fillSchema(schema);
+  pat::IdStore store;
+  store.setSchema(pat::IdSchemaRefProd(edm::RefCore(edm::ProductID(1, 1), 0, 0, false)));
+  store.set(0, 0.25f, &schema);
+  store.set(1, 1.f, &schema);
+  CPPUNIT_ASSERT(store.hasSchema() && store.schema() == 0);
+
+  // the IDs read as not available, without throwing
+  float value;
+  CPPUNIT_ASSERT(!store.isSet(0) && !store.get(0, value) && !store.get("mva", value));
+  pat::DiscriminatorHandle handle("loose");
+  CPPUNIT_ASSERT(!store.get(handle, value));
+  std::vector<std::pair<std::string, float> > stored;
+  store.fillPairs(stored);
+  CPPUNIT_ASSERT(stored.empty());
+
+  Ids ids;
+  Ids::Pairs pairs;
+  CPPUNIT_ASSERT(!Ids::get(store, pairs, "mva", value) && !Ids::get(store, pairs, handle, value));
+  CPPUNIT_ASSERT(ids.all(store, pairs).empty());
+  pat::IdMask mask;
+  mask.add("loose");
+  CPPUNIT_ASSERT(!Ids::passes(store, pairs, mask));
+  // the throwing access reports a missing ID, and storing without the schema content is an error
+  CPPUNIT_ASSERT_THROW(ids.get(store, pairs, "mva", "test"), cms::Exception);
+  Ids::Pairs input(1, Ids::Pair("mva", 0.5f));
+  CPPUNIT_ASSERT_THROW(ids.set(store, pairs, input, 0, "test"), cms::Exception);
+}
+
+void testIdStore::testMask() {
+  pat::IdSchema schema;
+  fillSchema(schema);
+  uint64_t bits = 0;
+  pat::IdMask mask;
+  CPPUNIT_ASSERT(mask.bits(&schema, bits) && bits == 0);
+  CPPUNIT_ASSERT(!mask.bits(0, bits));
+  mask.add("loose");
+  mask.add("veto");
+  CPPUNIT_ASSERT(mask.labels().size() == 2);
+  CPPUNIT_ASSERT(mask.bits(&schema, bits) && bits == 5);
+
+  // a float or missing ID can not be packed
+  std::vector<std::string> labels(1, "loose");
+  labels.push_back("mva");
+  pat::IdMask withFloat(labels);
+  CPPUNIT_ASSERT(!withFloat.bits(&schema, bits));
+  pat::IdMask missing(std::vector<std::string>(1, "medium"));
+  CPPUNIT_ASSERT(!missing.bits(&schema, bits));
+
+  // the packed test and the test one by one agree
+  pat::IdStore store;
+  store.setSchema(pat::IdSchemaRefProd(&schema));
+  pat::IdPairs<float>::Pairs pairs;
+  store.set(0, 0.9f);
+  store.set(1, 1.f);
+  store.set(3, 0.f);
+  CPPUNIT_ASSERT(!pat::IdPairs<float>::passes(store, pairs, mask));
+  store.set(3, 1.f);
+  CPPUNIT_ASSERT(pat::IdPairs<float>::passes(store, pairs, mask));
+  // a float above 0.5 passes when tested one by one
+  CPPUNIT_ASSERT(pat::IdPairs<float>::passes(store, pairs, withFloat));
+  store.set(0, 0.1f);
+  CPPUNIT_ASSERT(!pat::IdPairs<float>::passes(store, pairs, withFloat));
+  CPPUNIT_ASSERT(!pat::IdPairs<float>::passes(store, pairs, missing));
+
+  // without schema, the pairs are tested
+  pat::IdStore noSchema;
+  pairs.push_back(pat::IdPairs<float>::Pair("loose", 1.f));
+  pairs.push_back(pat::IdPairs<float>::Pair("veto", 1.f));
+  CPPUNIT_ASSERT(pat::IdPairs<float>::passes(noSchema, pairs, mask));
+  pairs[1].second = 0.f;
+  CPPUNIT_ASSERT(!pat::IdPairs<float>::passes(noSchema, pairs, mask));
+}
+
+void testIdStore::testMaskSchemaChange() {
+  // a schema rebuilt at the same address, e.g. in the next event, with the IDs in another order
+  pat::IdSchema schema;
+  fillSchema(schema);
+  pat::IdMask mask(std::vector<std::string>(1, "tight"));
+  uint64_t bits = 0;
+  CPPUNIT_ASSERT(mask.bits(&schema, bits) && bits == 2);
+
+  schema = pat::IdSchema();
+  schema.add("tight", pat::IdSchema::Boolean);
+  schema.add("loose", pat::IdSchema::Boolean);
+  CPPUNIT_ASSERT(mask.bits(&schema, bits) && bits == 1);
+
+  // and with the ID no longer boolean
+  schema = pat::IdSchema();
+  schema.add("loose", pat::IdSchema::Boolean);
+  schema.add("tight", pat::IdSchema::Float);
+  CPPUNIT_ASSERT(!mask.bits(&schema, bits));
+}
+
+void testIdStore::testPassAll() {
+  pat::IdSchema schema, floatSchema;
+  fillSchema(schema);
+  floatSchema.add("loose", pat::IdSchema::Float);
+  floatSchema.add("veto", pat::IdSchema::Float);
+
+  std::vector<IdObject> objects(5);
+  for (size_t i = 0; i < 3; ++i) objects[i].store.setSchema(pat::IdSchemaRefProd(&schema));
+  objects[0].store.set(1, 1.f); objects[0].store.set(3, 1.f);
+  objects[1].store.set(1, 1.f); objects[1].store.set(3, 0.f);
+  objects[2].store.set(1, 1.f);
+  // a different schema within the collection, in which the working points are not packed
+  objects[3].store.setSchema(pat::IdSchemaRefProd(&floatSchema));
+  objects[3].store.set(0, 1.f); objects[3].store.set(1, 0.8f);
+  // and an object from an old file, with pairs
+  objects[4].pairs.push_back(IdObject::Ids::Pair("loose", 1.f));
+
+  pat::IdMask mask;
+  mask.add("loose");
+  mask.add("veto");
+  std::vector<unsigned char> pass;
+  pat::IdStore::passAll(objects, &IdObject::idStore, &IdObject::passIds, mask, pass);
+  CPPUNIT_ASSERT(pass.size() == 5);
+  CPPUNIT_ASSERT(pass[0] == 1 && pass[1] == 0 && pass[2] == 0 && pass[3] == 1 && pass[4] == 0);
+  for (size_t i = 0; i < objects.size(); ++i) CPPUNIT_ASSERT(pass[i] == objects[i].passIds(mask));
+
+  pat::IdStore::passAll(std::vector<IdObject>(), &IdObject::idStore, &IdObject::passIds, mask, pass);
+  CPPUNIT_ASSERT(pass.empty());
+}
@@ -0,0 +1,96 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+#include <vector>
+
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DataFormats/PatCandidates/interface/JecHandle.h"
+
+namespace {
+  /// one set of correction factors with flavor independent levels of the given labels
+  pat::JetCorrFactors makeSet(const std::string& label, const char* const* levels, unsigned int n) {
+    std::vector<pat::JetCorrFactors::CorrectionFactor> factors;
+    for(unsigned int idx=0; idx<n; ++idx){
+      factors.push_back(pat::JetCorrFactors::CorrectionFactor(levels[idx], std::vector<float>(1, 1.f+0.1f*idx)));
+    }
+    return pat::JetCorrFactors(label, factors);
+  }
+}
+
+class testJecHandle : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testJecHandle);
+
+  CPPUNIT_TEST(testResolve);
+  CPPUNIT_TEST(testLevelLabels);
+  CPPUNIT_TEST(testSetLabels);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+
+  void testResolve();
+  void testLevelLabels();
+  void testSetLabels();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testJecHandle);
+
+void testJecHandle::testResolve() {
+  const char* const levels[] = { "Uncorrected", "L1FastJet", "L2Relative", "L3Absolute" };
+  std::vector<pat::JetCorrFactors> jec(1, makeSet("patJetCorrFactors", levels, 4));
+  pat::JecHandle handle("L3Absolute");
+  CPPUNIT_ASSERT(!handle.isResolvedFor(jec));
+  CPPUNIT_ASSERT(handle.resolve(jec));
+  CPPUNIT_ASSERT(handle.isResolvedFor(jec));
+  CPPUNIT_ASSERT(handle.setIndex()==0 && handle.levelIndex()==3);
+
+  pat::JecHandle missing("L5Flavor");
+  CPPUNIT_ASSERT(!missing.resolve(jec) && !missing.isResolvedFor(jec));
+  pat::JecHandle missingSet("L3Absolute", "none", "otherCorrFactors");
+  CPPUNIT_ASSERT(!missingSet.resolve(jec));
+  CPPUNIT_ASSERT_THROW(pat::JecHandle("L3Absolute", "bot"), cms::Exception);
+}
+
+void testJecHandle::testLevelLabels() {
+  // same sizes, but another label at the resolved level, or the levels in another order
+  const char* const fastJet[] = { "Uncorrected", "L1FastJet", "L2Relative", "L3Absolute" };
+  const char* const offset[] = { "Uncorrected", "L1Offset", "L2Relative", "L3Absolute" };
+  const char* const reordered[] = { "Uncorrected", "L2Relative", "L1FastJet", "L3Absolute" };
+  std::vector<pat::JetCorrFactors> jecFastJet(1, makeSet("patJetCorrFactors", fastJet, 4));
+  std::vector<pat::JetCorrFactors> jecOffset(1, makeSet("patJetCorrFactors", offset, 4));
+  std::vector<pat::JetCorrFactors> jecReordered(1, makeSet("patJetCorrFactors", reordered, 4));
+
+  pat::JecHandle handle("L1FastJet");
+  CPPUNIT_ASSERT(handle.resolve(jecFastJet) && handle.levelIndex()==1);
+  CPPUNIT_ASSERT(!handle.isResolvedFor(jecOffset));
+  CPPUNIT_ASSERT(!handle.resolve(jecOffset));
+  CPPUNIT_ASSERT(handle.resolve(jecFastJet));
+  CPPUNIT_ASSERT(!handle.isResolvedFor(jecReordered));
+  CPPUNIT_ASSERT(handle.resolve(jecReordered) && handle.levelIndex()==2);
+  CPPUNIT_ASSERT(handle.isResolvedFor(jecReordered) && !handle.isResolvedFor(jecFastJet));
+
+  // a level found at the same index in both layouts does not need to be resolved again
+  pat::JecHandle l3("L3Absolute");
+  CPPUNIT_ASSERT(l3.resolve(jecFastJet));
+  CPPUNIT_ASSERT(l3.isResolvedFor(jecOffset) && l3.isResolvedFor(jecReordered));
+}
+
+void testJecHandle::testSetLabels() {
+  // two sets of the same sizes in another order
+  const char* const levels[] = { "Uncorrected", "L2Relative", "L3Absolute" };
+  std::vector<pat::JetCorrFactors> jec, swapped;
+  jec.push_back(makeSet("ak5PF", levels, 3));
+  jec.push_back(makeSet("ak5PFchs", levels, 3));
+  swapped.push_back(jec[1]);
+  swapped.push_back(jec[0]);
+
+  pat::JecHandle handle("L2Relative", "none", "ak5PFchs");
+  CPPUNIT_ASSERT(handle.resolve(jec) && handle.setIndex()==1);
+  CPPUNIT_ASSERT(!handle.isResolvedFor(swapped));
+  CPPUNIT_ASSERT(handle.resolve(swapped) && handle.setIndex()==0);
+
+  // without a set label, the first set is used whatever its label
+  pat::JecHandle first("L2Relative");
+  CPPUNIT_ASSERT(first.resolve(jec) && first.setIndex()==0);
+  CPPUNIT_ASSERT(first.isResolvedFor(swapped));
+}
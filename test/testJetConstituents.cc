@@ -0,0 +1,82 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/Jet.h"
+#include "DataFormats/JetReco/interface/PFJet.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+#include "DataFormats/Common/interface/Ptr.h"
+#include "DataFormats/Common/interface/FwdPtr.h"
+
+class testJetConstituents : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testJetConstituents);
+
+  CPPUNIT_TEST(testDaughters);
+  CPPUNIT_TEST(testEmptyInput);
+  CPPUNIT_TEST(testFwdPtrs);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() ;
+  void tearDown() {}
+
+  void testDaughters();
+  void testEmptyInput();
+  void testFwdPtrs();
+
+private:
+  std::vector<reco::PFCandidate> cands_;
+  reco::PFJet pfJet_;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testJetConstituents);
+
+void testJetConstituents::setUp() {
+  cands_.clear();
+  cands_.push_back(reco::PFCandidate(+1, reco::Candidate::LorentzVector(10., 0., 5., 11.2), reco::PFCandidate::h));
+  cands_.push_back(reco::PFCandidate(0, reco::Candidate::LorentzVector(3., 3., 0., 4.3), reco::PFCandidate::gamma));
+  cands_.push_back(reco::PFCandidate(-1, reco::Candidate::LorentzVector(0., 8., 2., 8.3), reco::PFCandidate::h));
+  reco::Jet::Constituents constituents;
+  for (unsigned int i = 0; i < cands_.size(); ++i) constituents.push_back(reco::Jet::Constituent(&cands_, i));
+  pfJet_ = reco::PFJet(reco::Particle::LorentzVector(13., 11., 7., 24.), reco::Particle::Point(0., 0., 0.),
+                       reco::PFJet::Specific(), constituents);
+}
+
+void testJetConstituents::testDaughters() {
+  // nothing stored: the constituents are the daughters of the reco jet
+  pat::Jet jet(pfJet_);
+  CPPUNIT_ASSERT(jet.isPFJet());
+  CPPUNIT_ASSERT(jet.pfCandidatesStorage() == pat::Jet::NotEmbedded);
+  CPPUNIT_ASSERT(jet.numberOfDaughters() == 3);
+  CPPUNIT_ASSERT(jet.getPFConstituents().size() == 3);
+  CPPUNIT_ASSERT(jet.getPFConstituent(2).get() == &cands_[2]);
+}
+
+void testJetConstituents::testEmptyInput() {
+  // storing no constituents keeps the daughters of the reco jet, as before the storage form was recorded
+  pat::Jet jet(pfJet_);
+  jet.setPFCandidates(pat::PFCandidateFwdPtrCollection());
+  jet.setPackedPFCandidates(pat::PackedPFCandidateRefVector());
+  jet.setCaloTowers(pat::CaloTowerFwdPtrCollection());
+  CPPUNIT_ASSERT(jet.pfCandidatesStorage() == pat::Jet::NotEmbedded);
+  CPPUNIT_ASSERT(jet.caloTowersStorage() == pat::Jet::NotEmbedded);
+  CPPUNIT_ASSERT(jet.numberOfDaughters() == 3);
+  CPPUNIT_ASSERT(jet.pfConstituents().size() == 3);
+  CPPUNIT_ASSERT(jet.getPFConstituent(0).get() == &cands_[0]);
+}
+
+void testJetConstituents::testFwdPtrs() {
+  pat::Jet jet(pfJet_);
+  pat::PFCandidateFwdPtrCollection stored;
+  for (unsigned int i = 0; i < 2; ++i) {
+    reco::PFCandidatePtr ptr(&cands_, i);
+    stored.push_back(edm::FwdPtr<reco::PFCandidate>(ptr, ptr));
+  }
+  jet.setPFCandidates(stored);
+  CPPUNIT_ASSERT(jet.pfCandidatesStorage() == pat::Jet::FwdPtrEmbedded);
+  CPPUNIT_ASSERT(jet.numberOfDaughters() == 2);
+  CPPUNIT_ASSERT(jet.getPFConstituents().size() == 2);
+  CPPUNIT_ASSERT(jet.getPFConstituent(1)->pt() == cands_[1].pt());
+  // an empty collection afterwards leaves the stored constituents
+  jet.setPFCandidates(pat::PFCandidateFwdPtrCollection());
+  CPPUNIT_ASSERT(jet.pfCandidatesStorage() == pat::Jet::FwdPtrEmbedded && jet.numberOfDaughters() == 2);
+}
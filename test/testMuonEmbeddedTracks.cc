@@ -0,0 +1,141 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+namespace {
+  reco::Track makeTrack(double chi2, double ndof, double pz) {
+    return reco::Track(chi2, ndof, reco::Track::Point(0.01, 0.02, 0.5), reco::Track::Vector(10., 5., pz), -1,
+                       reco::Track::CovarianceMatrix());
+  }
+
+  /// gives access to the per-role storage, to fake muons read from files written before the track pool
+  class OldFileMuon : public pat::Muon {
+    public:
+      explicit OldFileMuon(const reco::Muon & muon) : pat::Muon(muon) {}
+      void setOldInnerTrack(const reco::Track & track) { track_.push_back(track); embeddedTrack_ = true; }
+      void setOldGlobalTrack(const reco::Track & track) { combinedMuon_.push_back(track); embeddedCombinedMuon_ = true; }
+  };
+}
+
+class testMuonEmbeddedTracks : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testMuonEmbeddedTracks);
+
+  CPPUNIT_TEST(testSharedTrack);
+  CPPUNIT_TEST(testSameContent);
+  CPPUNIT_TEST(testDifferentFits);
+  CPPUNIT_TEST(testCopy);
+  CPPUNIT_TEST(testOldFile);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() ;
+  void tearDown() {}
+
+  void testSharedTrack();
+  void testSameContent();
+  void testDifferentFits();
+  void testCopy();
+  void testOldFile();
+
+private:
+  std::vector<reco::Track> tracks_;
+  reco::Muon muon_;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testMuonEmbeddedTracks);
+
+void testMuonEmbeddedTracks::setUp() {
+  tracks_.clear();
+  tracks_.push_back(makeTrack(5., 10., 20.));   // inner
+  tracks_.push_back(makeTrack(20., 30., 20.));  // global
+  tracks_.push_back(makeTrack(8., 12., 21.));   // outer
+  tracks_.push_back(makeTrack(21., 30., 20.));  // global with another fit
+  tracks_.push_back(makeTrack(20., 30., 20.0001));
+  muon_ = reco::Muon(-1, reco::Particle::LorentzVector(10., 5., 20., 23.));
+  muon_.setInnerTrack(reco::TrackRef(&tracks_, 0));
+  muon_.setGlobalTrack(reco::TrackRef(&tracks_, 1));
+  muon_.setOuterTrack(reco::TrackRef(&tracks_, 2));
+  muon_.setBestTrack(reco::Muon::CombinedTrack);
+}
+
+void testMuonEmbeddedTracks::testSharedTrack() {
+  pat::Muon muon(muon_);
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 0);
+  CPPUNIT_ASSERT(muon.muonBestTrack().get() == &tracks_[1]);
+  muon.embedMuonBestTrack();
+  muon.embedTrack();
+  muon.embedStandAloneMuon();
+  muon.embedCombinedMuon();
+  // the best track is the global track: stored once
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 3);
+  CPPUNIT_ASSERT(muon.muonBestTrack().get() == muon.globalTrack().get());
+  CPPUNIT_ASSERT(muon.globalTrack().get() != &tracks_[1]);
+  CPPUNIT_ASSERT(muon.globalTrack()->chi2() == 20. && muon.innerTrack()->chi2() == 5. && muon.outerTrack()->chi2() == 8.);
+  CPPUNIT_ASSERT(muon.innerTrack().get() != &tracks_[0] && muon.outerTrack().get() != &tracks_[2]);
+
+  // embedding again does not add tracks, and roles without track embed nothing
+  muon.embedCombinedMuon();
+  muon.embedPickyMuon();
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 3);
+  CPPUNIT_ASSERT(muon.pickyTrack().isNull());
+}
+
+void testMuonEmbeddedTracks::testSameContent() {
+  // two Refs to identical tracks in different collections are one track
+  std::vector<reco::Track> copies(tracks_);
+  muon_.setInnerTrack(reco::TrackRef(&copies, 1));
+  pat::Muon muon(muon_);
+  muon.embedTrack();
+  muon.embedCombinedMuon();
+  muon.embedMuonBestTrack();
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 1);
+  CPPUNIT_ASSERT(muon.innerTrack().get() == muon.globalTrack().get());
+  CPPUNIT_ASSERT(muon.muonBestTrack().get() == muon.globalTrack().get());
+}
+
+void testMuonEmbeddedTracks::testDifferentFits() {
+  // tracks which differ only by their fit are kept apart
+  muon_.setInnerTrack(reco::TrackRef(&tracks_, 3));
+  muon_.setOuterTrack(reco::TrackRef(&tracks_, 4));
+  pat::Muon muon(muon_);
+  muon.embedTrack();
+  muon.embedStandAloneMuon();
+  muon.embedCombinedMuon();
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 3);
+  CPPUNIT_ASSERT(muon.innerTrack()->chi2() == 21. && muon.globalTrack()->chi2() == 20.);
+  CPPUNIT_ASSERT(muon.outerTrack()->pz() == tracks_[4].pz());
+}
+
+void testMuonEmbeddedTracks::testCopy() {
+  // the Refs of a copy point into its own pool, as for a muon read from a file
+  pat::Muon original(muon_);
+  original.embedMuonBestTrack();
+  original.embedCombinedMuon();
+  pat::Muon muon(original);
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 1);
+  CPPUNIT_ASSERT(muon.globalTrack().get() == muon.muonBestTrack().get());
+  CPPUNIT_ASSERT(muon.globalTrack().get() != original.globalTrack().get());
+  CPPUNIT_ASSERT(muon.globalTrack()->chi2() == 20.);
+}
+
+void testMuonEmbeddedTracks::testOldFile() {
+  // tracks embedded per role, as in files written before the pool
+  reco::Track oldInner = makeTrack(6., 10., 20.), oldGlobal = makeTrack(22., 30., 20.);
+  OldFileMuon muon(muon_);
+  muon.setOldInnerTrack(oldInner);
+  muon.setOldGlobalTrack(oldGlobal);
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 0);
+  CPPUNIT_ASSERT(muon.innerTrack().isNonnull() && muon.innerTrack()->chi2() == 6.);
+  CPPUNIT_ASSERT(muon.globalTrack()->chi2() == 22.);
+  // the roles not embedded still read the original tracks
+  CPPUNIT_ASSERT(muon.outerTrack().get() == &tracks_[2]);
+
+  // a role embedded later goes to the pool, and the others keep their per-role tracks
+  muon.embedStandAloneMuon();
+  CPPUNIT_ASSERT(muon.numberOfEmbeddedTracks() == 1);
+  CPPUNIT_ASSERT(muon.outerTrack()->chi2() == 8. && muon.outerTrack().get() != &tracks_[2]);
+  CPPUNIT_ASSERT(muon.innerTrack()->chi2() == 6. && muon.globalTrack()->chi2() == 22.);
+}
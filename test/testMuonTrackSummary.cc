@@ -0,0 +1,170 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <cmath>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/MuonTrackSummary.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+namespace {
+  reco::Track makeTrack(double chi2, double ndof, const reco::Track::Point & point, const reco::Track::Vector & momentum) {
+    return reco::Track(chi2, ndof, point, momentum, -1, reco::Track::CovarianceMatrix());
+  }
+
+  /// summary of a muon passing the tight and soft identifications, with tracks at the origin along x
+  pat::MuonTrackSummary goodSummary() {
+    pat::MuonTrackSummary summary;
+    summary.flags = pat::MuonTrackSummary::Filled | pat::MuonTrackSummary::PFMuon | pat::MuonTrackSummary::GlobalMuon |
+                    pat::MuonTrackSummary::TrackerMuon | pat::MuonTrackSummary::TMOneStationTight;
+    summary.inner.present = true;
+    summary.inner.px = 20.f;
+    summary.inner.normChi2 = 1.f;
+    summary.inner.validFraction = 1.f;
+    summary.inner.trackerLayers = 10;
+    summary.inner.pixelLayers = 3;
+    summary.inner.validPixelHits = 3;
+    summary.global = summary.inner;
+    summary.global.validMuonHits = 20;
+    summary.best = summary.inner;
+    summary.matchedStations = 3;
+    summary.segmentCompatibility = 0.9f;
+    return summary;
+  }
+}
+
+class testMuonTrackSummary : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testMuonTrackSummary);
+
+  CPPUNIT_TEST(testImpactParameters);
+  CPPUNIT_TEST(testFill);
+  CPPUNIT_TEST(testLooseCuts);
+  CPPUNIT_TEST(testMediumCuts);
+  CPPUNIT_TEST(testTightCuts);
+  CPPUNIT_TEST(testSoftCuts);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+
+  void testImpactParameters();
+  void testFill();
+  void testLooseCuts();
+  void testMediumCuts();
+  void testTightCuts();
+  void testSoftCuts();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testMuonTrackSummary);
+
+void testMuonTrackSummary::testImpactParameters() {
+  std::vector<reco::Track> tracks;
+  tracks.push_back(makeTrack(10., 8., reco::Track::Point(0.05, 0.03, 1.2), reco::Track::Vector(20., -15., 30.)));
+  tracks.push_back(makeTrack(10., 8., reco::Track::Point(-0.3, 0.1, -4.), reco::Track::Vector(-3., 2., -1.)));
+  tracks.push_back(makeTrack(10., 8., reco::Track::Point(0., 0., 0.), reco::Track::Vector(0.5, 0.5, 100.)));
+  std::vector<math::XYZPoint> vertices;
+  vertices.push_back(math::XYZPoint(0., 0., 0.));
+  vertices.push_back(math::XYZPoint(0.01, -0.02, 0.5));
+  vertices.push_back(math::XYZPoint(0.2, 0.3, -10.));
+
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    pat::MuonTrackQuality quality;
+    quality.fill(tracks[i]);
+    for (size_t j = 0; j < vertices.size(); ++j) {
+      // the same as reco::TrackBase, up to the float precision of the summary
+      const double dxy = tracks[i].dxy(vertices[j]), dz = tracks[i].dz(vertices[j]);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(dxy, quality.dxy(vertices[j]), 1.e-5 * (1. + std::abs(dxy)));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(dz, quality.dz(vertices[j]), 1.e-5 * (1. + std::abs(dz)));
+    }
+  }
+
+  // a track without momentum does not give NaN
+  pat::MuonTrackQuality empty;
+  CPPUNIT_ASSERT(empty.dxy(vertices[1]) == empty.dxy(vertices[1]) && empty.dz(vertices[1]) == empty.dz(vertices[1]));
+}
+
+void testMuonTrackSummary::testFill() {
+  reco::Track track = makeTrack(12., 6., reco::Track::Point(0.05, 0.03, 1.2), reco::Track::Vector(20., -15., 30.));
+  pat::MuonTrackQuality quality;
+  CPPUNIT_ASSERT(!quality.present);
+  quality.fill(track);
+  CPPUNIT_ASSERT(quality.present);
+  CPPUNIT_ASSERT(quality.normChi2 == 2.f);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(track.ptError(), quality.ptError, 1.e-6);
+  CPPUNIT_ASSERT(quality.vz == float(track.vz()) && quality.px == float(track.px()) && quality.pz == float(track.pz()));
+  // no hits: no valid fraction
+  CPPUNIT_ASSERT(quality.validHits == 0 && quality.validFraction == 0.f);
+}
+
+void testMuonTrackSummary::testLooseCuts() {
+  typedef pat::MuonTrackSummary S;
+  CPPUNIT_ASSERT(S::looseCuts(S::PFMuon | S::GlobalMuon) == 1);
+  CPPUNIT_ASSERT(S::looseCuts(S::PFMuon | S::TrackerMuon) == 1);
+  CPPUNIT_ASSERT(S::looseCuts(S::PFMuon) == 0);
+  CPPUNIT_ASSERT(S::looseCuts(S::GlobalMuon | S::TrackerMuon) == 0);
+
+  S summary = goodSummary();
+  CPPUNIT_ASSERT(summary.isFilled() && summary.hasFlag(S::TrackerMuon) && summary.isLooseMuon());
+  summary.flags &= ~S::PFMuon;
+  CPPUNIT_ASSERT(!summary.isLooseMuon() && !summary.isMediumMuon());
+}
+
+void testMuonTrackSummary::testMediumCuts() {
+  typedef pat::MuonTrackSummary S;
+  const uint8_t global = S::PFMuon | S::GlobalMuon, tracker = S::PFMuon | S::TrackerMuon;
+  // a good global muon needs a segment compatibility above 0.303, otherwise above 0.451
+  CPPUNIT_ASSERT(S::mediumCuts(global, 0.9f, 2.f, 5.f, 10.f, 0.35f) == 1);
+  CPPUNIT_ASSERT(S::mediumCuts(global, 0.9f, 2.f, 5.f, 10.f, 0.30f) == 0);
+  CPPUNIT_ASSERT(S::mediumCuts(global, 0.9f, 4.f, 5.f, 10.f, 0.35f) == 0);
+  CPPUNIT_ASSERT(S::mediumCuts(global, 0.9f, 2.f, 13.f, 10.f, 0.35f) == 0);
+  CPPUNIT_ASSERT(S::mediumCuts(global, 0.9f, 2.f, 5.f, 25.f, 0.35f) == 0);
+  CPPUNIT_ASSERT(S::mediumCuts(global, 0.9f, 2.f, 5.f, 25.f, 0.5f) == 1);
+  CPPUNIT_ASSERT(S::mediumCuts(tracker, 0.9f, 2.f, 5.f, 10.f, 0.35f) == 0);
+  CPPUNIT_ASSERT(S::mediumCuts(tracker, 0.9f, 2.f, 5.f, 10.f, 0.5f) == 1);
+  CPPUNIT_ASSERT(S::mediumCuts(tracker, 0.8f, 2.f, 5.f, 10.f, 0.5f) == 0);
+  CPPUNIT_ASSERT(S::mediumCuts(S::GlobalMuon, 0.9f, 2.f, 5.f, 10.f, 0.9f) == 0);
+
+  S summary = goodSummary();
+  CPPUNIT_ASSERT(summary.isMediumMuon());
+  summary.inner.validFraction = 0.5f;
+  CPPUNIT_ASSERT(!summary.isMediumMuon());
+}
+
+void testMuonTrackSummary::testTightCuts() {
+  typedef pat::MuonTrackSummary S;
+  const uint8_t flags = S::PFMuon | S::GlobalMuon;
+  CPPUNIT_ASSERT(S::tightCuts(flags, 5.f, 1, 2, 6, 1, 0.1f, 0.3f) == 1);
+  CPPUNIT_ASSERT(S::tightCuts(S::PFMuon | S::TrackerMuon, 5.f, 1, 2, 6, 1, 0.1f, 0.3f) == 0);
+  CPPUNIT_ASSERT(S::tightCuts(flags, 10.f, 1, 2, 6, 1, 0.1f, 0.3f) == 0);
+  CPPUNIT_ASSERT(S::tightCuts(flags, 5.f, 0, 2, 6, 1, 0.1f, 0.3f) == 0);
+  CPPUNIT_ASSERT(S::tightCuts(flags, 5.f, 1, 1, 6, 1, 0.1f, 0.3f) == 0);
+  CPPUNIT_ASSERT(S::tightCuts(flags, 5.f, 1, 2, 5, 1, 0.1f, 0.3f) == 0);
+  CPPUNIT_ASSERT(S::tightCuts(flags, 5.f, 1, 2, 6, 0, 0.1f, 0.3f) == 0);
+  CPPUNIT_ASSERT(S::tightCuts(flags, 5.f, 1, 2, 6, 1, 0.2f, 0.3f) == 0);
+  CPPUNIT_ASSERT(S::tightCuts(flags, 5.f, 1, 2, 6, 1, 0.1f, 0.5f) == 0);
+
+  // the impact parameters are taken from the best track with respect to the vertex
+  S summary = goodSummary();
+  CPPUNIT_ASSERT(summary.isTightMuon(math::XYZPoint(0., 0.1, 0.2)));
+  CPPUNIT_ASSERT(!summary.isTightMuon(math::XYZPoint(0., 0.3, 0.)));
+  CPPUNIT_ASSERT(!summary.isTightMuon(math::XYZPoint(0., 0., 0.6)));
+  summary.best.vy = 0.3f;
+  CPPUNIT_ASSERT(summary.isTightMuon(math::XYZPoint(0., 0.3, 0.)));
+}
+
+void testMuonTrackSummary::testSoftCuts() {
+  typedef pat::MuonTrackSummary S;
+  const uint8_t flags = S::TMOneStationTight;
+  CPPUNIT_ASSERT(S::softCuts(flags, 6, 2, 1.f, 2.f, 20.f) == 1);
+  CPPUNIT_ASSERT(S::softCuts(S::PFMuon | S::GlobalMuon, 6, 2, 1.f, 2.f, 20.f) == 0);
+  CPPUNIT_ASSERT(S::softCuts(flags, 5, 2, 1.f, 2.f, 20.f) == 0);
+  CPPUNIT_ASSERT(S::softCuts(flags, 6, 1, 1.f, 2.f, 20.f) == 0);
+  CPPUNIT_ASSERT(S::softCuts(flags, 6, 2, 1.8f, 2.f, 20.f) == 0);
+  CPPUNIT_ASSERT(S::softCuts(flags, 6, 2, 1.f, 3.f, 20.f) == 0);
+  CPPUNIT_ASSERT(S::softCuts(flags, 6, 2, 1.f, 2.f, 30.f) == 0);
+
+  // the impact parameters are taken from the inner track
+  S summary = goodSummary();
+  CPPUNIT_ASSERT(summary.isSoftMuon(math::XYZPoint(0., 2., 20.)));
+  CPPUNIT_ASSERT(!summary.isSoftMuon(math::XYZPoint(0., 3.5, 0.)));
+  CPPUNIT_ASSERT(!summary.isSoftMuon(math::XYZPoint(0., 0., -31.)));
+}
@@ -0,0 +1,156 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/Particle.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+
+namespace {
+  /// gives access to the storage, to fake objects read from files
+  class OverlapTestParticle : public pat::Particle {
+    public:
+      /// add a label as in files written with the per-label storage
+      void setLegacyOverlaps(const std::string & label, const reco::CandidatePtrVector & items) {
+        overlapLabels_.push_back(label);
+        overlapItems_.push_back(items);
+      }
+      /// drop the transient Ptrs, as after reading the flat storage from a file
+      void dropTransientOverlaps() { overlapItemsTransient_.clear(); }
+      size_t numberOfOverlapProducts() const { return overlapProducts_.size(); }
+      const std::vector<uint32_t> & overlapOffsets() const { return overlapOffsets_; }
+      bool hasLegacyOverlaps() const { return !overlapItems_.empty(); }
+  };
+
+  reco::CandidatePtrVector makeOverlaps(unsigned int process, unsigned int first, unsigned int n) {
+    reco::CandidatePtrVector ret;
+    for (unsigned int i = 0; i < n; ++i) ret.push_back(reco::CandidatePtr(edm::ProductID(process, 1), first + i, 0));
+    return ret;
+  }
+
+  template<typename View>
+  bool sameKeys(const View & view, const reco::CandidatePtrVector & items) {
+    if (view.size() != items.size()) return false;
+    for (size_t i = 0, n = items.size(); i < n; ++i) {
+      if (view[i].id() != items[i].id() || view[i].key() != items[i].key()) return false;
+    }
+    return true;
+  }
+}
+
+class testOverlapStorage : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testOverlapStorage);
+
+  CPPUNIT_TEST(testSet);
+  CPPUNIT_TEST(testReplace);
+  CPPUNIT_TEST(testReadBack);
+  CPPUNIT_TEST(testMigrate);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+
+  void testSet();
+  void testReplace();
+  void testReadBack();
+  void testMigrate();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testOverlapStorage);
+
+void testOverlapStorage::testSet() {
+  OverlapTestParticle part;
+  reco::CandidatePtrVector muons = makeOverlaps(1, 3, 2), electrons = makeOverlaps(2, 10, 3), jets = makeOverlaps(1, 7, 1);
+  part.setOverlaps("muons", muons);
+  part.setOverlaps("electrons", electrons);
+  part.setOverlaps("jets", jets);
+  part.setOverlaps("nothing", reco::CandidatePtrVector());
+
+  CPPUNIT_ASSERT(part.overlapLabels().size() == 3);
+  CPPUNIT_ASSERT(part.hasOverlaps("muons") && part.hasOverlaps("electrons") && part.hasOverlaps("jets"));
+  CPPUNIT_ASSERT(!part.hasOverlaps("nothing"));
+  // muons and jets share their product
+  CPPUNIT_ASSERT(part.numberOfOverlapProducts() == 2);
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("muons"), muons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("electrons"), electrons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("jets"), jets));
+  CPPUNIT_ASSERT(part.overlapsView("nothing").empty());
+  CPPUNIT_ASSERT(sameKeys(part.overlaps("electrons"), electrons));
+  CPPUNIT_ASSERT(part.overlaps("nothing").empty());
+  CPPUNIT_ASSERT(!part.hasLegacyOverlaps());
+}
+
+void testOverlapStorage::testReplace() {
+  OverlapTestParticle part;
+  reco::CandidatePtrVector muons = makeOverlaps(1, 3, 2), electrons = makeOverlaps(2, 10, 3), jets = makeOverlaps(1, 7, 1);
+  part.setOverlaps("muons", muons);
+  part.setOverlaps("electrons", electrons);
+  part.setOverlaps("jets", jets);
+  CPPUNIT_ASSERT(sameKeys(part.overlaps("muons"), muons));
+
+  // more items for the first label: the offsets of the later ones move
+  reco::CandidatePtrVector moreMuons = makeOverlaps(3, 0, 4);
+  part.setOverlaps("muons", moreMuons);
+  CPPUNIT_ASSERT(part.overlapLabels().size() == 3);
+  CPPUNIT_ASSERT(part.overlapOffsets().size() == 4);
+  CPPUNIT_ASSERT(part.overlapOffsets()[1] == 4 && part.overlapOffsets()[2] == 7 && part.overlapOffsets()[3] == 8);
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("muons"), moreMuons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("electrons"), electrons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("jets"), jets));
+  // the PtrVectors of overlaps() are rebuilt after the change
+  CPPUNIT_ASSERT(sameKeys(part.overlaps("muons"), moreMuons));
+  CPPUNIT_ASSERT(sameKeys(part.overlaps("jets"), jets));
+
+  // fewer items for the middle label
+  reco::CandidatePtrVector oneElectron = makeOverlaps(2, 20, 1);
+  part.setOverlaps("electrons", oneElectron);
+  CPPUNIT_ASSERT(part.overlapOffsets()[2] == 5 && part.overlapOffsets()[3] == 6);
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("electrons"), oneElectron));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("jets"), jets));
+  CPPUNIT_ASSERT(sameKeys(part.overlaps("electrons"), oneElectron));
+}
+
+void testOverlapStorage::testReadBack() {
+  OverlapTestParticle part;
+  reco::CandidatePtrVector muons = makeOverlaps(1, 3, 2), electrons = makeOverlaps(2, 10, 3);
+  part.setOverlaps("muons", muons);
+  part.setOverlaps("electrons", electrons);
+
+  // without the transient Ptrs, the items are made from the product table and the keys
+  part.dropTransientOverlaps();
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("muons"), muons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("electrons"), electrons));
+  pat::OverlapView view = part.overlapsView("electrons");
+  std::vector<reco::CandidatePtr> items(view.begin(), view.end());
+  CPPUNIT_ASSERT(items.size() == 3 && items[2].key() == 12);
+
+  // and a later change keeps the labels read before it
+  reco::CandidatePtrVector jets = makeOverlaps(1, 7, 1);
+  part.setOverlaps("jets", jets);
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("muons"), muons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("jets"), jets));
+}
+
+void testOverlapStorage::testMigrate() {
+  OverlapTestParticle part;
+  reco::CandidatePtrVector muons = makeOverlaps(1, 3, 2), electrons = makeOverlaps(2, 10, 3);
+  part.setLegacyOverlaps("muons", muons);
+  part.setLegacyOverlaps("electrons", electrons);
+
+  // the old storage is read as it is
+  CPPUNIT_ASSERT(part.hasLegacyOverlaps());
+  CPPUNIT_ASSERT(sameKeys(part.overlaps("muons"), muons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("electrons"), electrons));
+
+  // and moved into the flat storage by the first change
+  reco::CandidatePtrVector jets = makeOverlaps(1, 7, 1);
+  part.setOverlaps("jets", jets);
+  CPPUNIT_ASSERT(!part.hasLegacyOverlaps());
+  CPPUNIT_ASSERT(part.overlapLabels().size() == 3);
+  CPPUNIT_ASSERT(part.overlapLabels()[0] == "muons" && part.overlapLabels()[2] == "jets");
+  CPPUNIT_ASSERT(part.numberOfOverlapProducts() == 2);
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("muons"), muons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("electrons"), electrons));
+  CPPUNIT_ASSERT(sameKeys(part.overlapsView("jets"), jets));
+  CPPUNIT_ASSERT(sameKeys(part.overlaps("muons"), muons));
+}
@@ -0,0 +1,126 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/RecHitFootprint.h"
+#include "DataFormats/EcalDetId/interface/EBDetId.h"
+#include "DataFormats/EcalDetId/interface/EEDetId.h"
+
+class testRecHitFootprint : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testRecHitFootprint);
+
+  CPPUNIT_TEST(testBarrelWindow);
+  CPPUNIT_TEST(testBarrelEdge);
+  CPPUNIT_TEST(testEndcapOuterEdge);
+  CPPUNIT_TEST(testEndcapInnerEdge);
+  CPPUNIT_TEST(testFill);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() {}
+  void tearDown() {}
+
+  void testBarrelWindow();
+  void testBarrelEdge();
+  void testEndcapOuterEdge();
+  void testEndcapInnerEdge();
+  void testFill();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testRecHitFootprint);
+
+void testRecHitFootprint::testBarrelWindow() {
+  // 5x5 around ieta = 1, iphi = 1: skips ieta = 0 and wraps around in phi
+  std::vector<DetId> window;
+  pat::RecHitFootprint::addSquareWindow(EBDetId(1, 1), 2, window);
+  CPPUNIT_ASSERT(window.size() == 25);
+  std::set<int> ietas, iphis;
+  for (std::vector<DetId>::const_iterator it = window.begin(); it != window.end(); ++it) {
+    EBDetId id(*it);
+    ietas.insert(id.ieta());
+    iphis.insert(id.iphi());
+  }
+  const int expectedEtas[] = { -2, -1, 1, 2, 3 };
+  const int expectedPhis[] = { 1, 2, 3, 359, 360 };
+  CPPUNIT_ASSERT(ietas == std::set<int>(expectedEtas, expectedEtas + 5));
+  CPPUNIT_ASSERT(iphis == std::set<int>(expectedPhis, expectedPhis + 5));
+  CPPUNIT_ASSERT(std::find(window.begin(), window.end(), DetId(EBDetId(1, 1))) != window.end());
+
+  // and symmetrically on the negative side, wrapping the other way
+  window.clear();
+  pat::RecHitFootprint::addSquareWindow(EBDetId(-1, 360), 1, window);
+  CPPUNIT_ASSERT(window.size() == 9);
+  CPPUNIT_ASSERT(std::find(window.begin(), window.end(), DetId(EBDetId(1, 1))) != window.end());
+  CPPUNIT_ASSERT(std::find(window.begin(), window.end(), DetId(EBDetId(-2, 359))) != window.end());
+}
+
+void testRecHitFootprint::testBarrelEdge() {
+  // the crystals beyond |ieta| = 85 do not exist
+  std::vector<DetId> window;
+  pat::RecHitFootprint::addSquareWindow(EBDetId(85, 100), 2, window);
+  CPPUNIT_ASSERT(window.size() == 15);
+  for (std::vector<DetId>::const_iterator it = window.begin(); it != window.end(); ++it) {
+    CPPUNIT_ASSERT(EBDetId(*it).ieta() >= 83 && EBDetId(*it).ieta() <= 85);
+  }
+  // the window is appended to
+  pat::RecHitFootprint::addSquareWindow(EBDetId(-85, 100), 2, window);
+  CPPUNIT_ASSERT(window.size() == 30);
+}
+
+void testRecHitFootprint::testEndcapOuterEdge() {
+  CPPUNIT_ASSERT(EEDetId::validDetId(1, 50, 1));
+  std::vector<DetId> window;
+  pat::RecHitFootprint::addSquareWindow(EEDetId(1, 50, 1), 2, window);
+  CPPUNIT_ASSERT(!window.empty() && window.size() <= 15);
+  CPPUNIT_ASSERT(std::find(window.begin(), window.end(), DetId(EEDetId(1, 50, 1))) != window.end());
+  for (std::vector<DetId>::const_iterator it = window.begin(); it != window.end(); ++it) {
+    EEDetId id(*it);
+    CPPUNIT_ASSERT(EEDetId::validDetId(id.ix(), id.iy(), id.zside()));
+    CPPUNIT_ASSERT(id.zside() == 1 && id.ix() >= 1 && id.ix() <= 3);
+  }
+}
+
+void testRecHitFootprint::testEndcapInnerEdge() {
+  // first crystal below the inner hole of the endcap, on the negative side
+  int iy = 50;
+  while (iy > 0 && !EEDetId::validDetId(50, iy, -1)) --iy;
+  CPPUNIT_ASSERT(iy > 0);
+  std::vector<DetId> window;
+  pat::RecHitFootprint::addSquareWindow(EEDetId(50, iy, -1), 2, window);
+  CPPUNIT_ASSERT(!window.empty() && window.size() < 25);
+  CPPUNIT_ASSERT(std::find(window.begin(), window.end(), DetId(EEDetId(50, iy, -1))) != window.end());
+  for (std::vector<DetId>::const_iterator it = window.begin(); it != window.end(); ++it) {
+    EEDetId id(*it);
+    CPPUNIT_ASSERT(EEDetId::validDetId(id.ix(), id.iy(), id.zside()));
+    CPPUNIT_ASSERT(id.zside() == -1);
+  }
+}
+
+void testRecHitFootprint::testFill() {
+  EcalRecHitCollection recHits;
+  recHits.push_back(EcalRecHit(EBDetId(1, 1), 10.f, 0.5f));
+  recHits.push_back(EcalRecHit(EBDetId(-1, 360), 2.f, -1.f));
+  recHits.push_back(EcalRecHit(EBDetId(20, 20), 7.f, 0.f));
+  recHits.sort();
+
+  std::vector<DetId> window;
+  pat::RecHitFootprint::addSquareWindow(EBDetId(1, 1), 1, window);
+  pat::RecHitFootprint::addSquareWindow(EBDetId(-1, 1), 1, window);
+  pat::RecHitFootprint footprint;
+  footprint.fill(recHits, window);
+  // duplicates and ids without a rechit are dropped
+  CPPUNIT_ASSERT(footprint.size() == 2);
+  CPPUNIT_ASSERT(footprint.detIds()[0] < footprint.detIds()[1]);
+  CPPUNIT_ASSERT(footprint.contains(EBDetId(1, 1)) && footprint.contains(EBDetId(-1, 360)));
+  CPPUNIT_ASSERT(!footprint.contains(EBDetId(20, 20)));
+  CPPUNIT_ASSERT(footprint.energy(EBDetId(1, 1)) == 10.f);
+  CPPUNIT_ASSERT(footprint.energy(EBDetId(20, 20)) == 0.f);
+  CPPUNIT_ASSERT(footprint.time(footprint.index(EBDetId(-1, 360))) == -1.f);
+
+  EcalRecHitCollection unpacked;
+  footprint.unpack(unpacked);
+  CPPUNIT_ASSERT(unpacked.size() == 2);
+  CPPUNIT_ASSERT(unpacked.find(EBDetId(-1, 360)) != unpacked.end());
+  CPPUNIT_ASSERT(unpacked.find(EBDetId(-1, 360))->energy() == 2.f);
+}
@@ -0,0 +1,151 @@
+#include <cppunit/extensions/HelperMacros.h>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/Tau.h"
+#include "DataFormats/TauReco/interface/PFTau.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+
+namespace {
+  reco::PFCandidateRefVector makeRefs(const std::vector<reco::PFCandidate> & cands, const unsigned int * keys, unsigned int n) {
+    reco::PFCandidateRefVector ret;
+    for (unsigned int i = 0; i < n; ++i) ret.push_back(reco::PFCandidateRef(&cands, keys[i]));
+    return ret;
+  }
+
+  /// true if the view holds the candidates of the refs, compared by value
+  bool sameCands(const pat::TauPFCandidateView & view, const reco::PFCandidateRefVector & refs) {
+    if (view.size() != refs.size()) return false;
+    for (size_t i = 0, n = refs.size(); i < n; ++i) {
+      if (view[i] == 0 || view[i]->pt() != refs[i]->pt() || view[i]->particleId() != refs[i]->particleId()) return false;
+    }
+    return true;
+  }
+}
+
+class testTauPFCandSubsets : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(testTauPFCandSubsets);
+
+  CPPUNIT_TEST(testSubsetsBeforeAll);
+  CPPUNIT_TEST(testSubsetsAfterAll);
+  CPPUNIT_TEST(testSubsetNotInAll);
+  CPPUNIT_TEST(testCopy);
+
+  CPPUNIT_TEST_SUITE_END();
+public:
+  void setUp() ;
+  void tearDown() {}
+
+  void testSubsetsBeforeAll();
+  void testSubsetsAfterAll();
+  void testSubsetNotInAll();
+  void testCopy();
+
+private:
+  std::vector<reco::PFCandidate> cands_;
+  reco::PFTau tau_;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(testTauPFCandSubsets);
+
+void testTauPFCandSubsets::setUp() {
+  cands_.clear();
+  cands_.push_back(reco::PFCandidate(+1, reco::Candidate::LorentzVector(10., 0., 5., 11.2), reco::PFCandidate::h));
+  cands_.push_back(reco::PFCandidate(-1, reco::Candidate::LorentzVector(0., 8., 2., 8.3), reco::PFCandidate::h));
+  cands_.push_back(reco::PFCandidate(0, reco::Candidate::LorentzVector(3., 3., 0., 4.3), reco::PFCandidate::gamma));
+  cands_.push_back(reco::PFCandidate(0, reco::Candidate::LorentzVector(-2., 1., 1., 2.5), reco::PFCandidate::h0));
+  cands_.push_back(reco::PFCandidate(+1, reco::Candidate::LorentzVector(1., -1., 0., 1.5), reco::PFCandidate::h));
+  cands_.push_back(reco::PFCandidate(0, reco::Candidate::LorentzVector(0., -1.5, 0., 1.5), reco::PFCandidate::gamma));
+  cands_.push_back(reco::PFCandidate(-1, reco::Candidate::LorentzVector(0.5, 0.5, 0., 0.8), reco::PFCandidate::h));
+
+  const unsigned int signal[] = { 0, 1, 2, 3 }, signalCharged[] = { 0, 1 }, signalNeutral[] = { 3 }, signalGamma[] = { 2 };
+  const unsigned int isolation[] = { 4, 5 }, isolationCharged[] = { 4 }, isolationGamma[] = { 5 };
+  tau_ = reco::PFTau();
+  tau_.setsignalPFCands(makeRefs(cands_, signal, 4));
+  tau_.setsignalPFChargedHadrCands(makeRefs(cands_, signalCharged, 2));
+  tau_.setsignalPFNeutrHadrCands(makeRefs(cands_, signalNeutral, 1));
+  tau_.setsignalPFGammaCands(makeRefs(cands_, signalGamma, 1));
+  tau_.setisolationPFCands(makeRefs(cands_, isolation, 2));
+  tau_.setisolationPFChargedHadrCands(makeRefs(cands_, isolationCharged, 1));
+  tau_.setisolationPFGammaCands(makeRefs(cands_, isolationGamma, 1));
+}
+
+void testTauPFCandSubsets::testSubsetsBeforeAll() {
+  pat::Tau tau(tau_);
+  CPPUNIT_ASSERT(tau.isPFTau());
+  tau.embedSignalPFChargedHadrCands();
+  tau.embedSignalPFGammaCands();
+  // a second call does not store the candidates again
+  tau.embedSignalPFChargedHadrCands();
+
+  // the full vector is not embedded: it still refers to the original candidates
+  CPPUNIT_ASSERT(tau.signalPFCands().size() == 4);
+  CPPUNIT_ASSERT(tau.signalPFCands()[0].get() == &cands_[0]);
+  CPPUNIT_ASSERT(!tau.signalPFCandsView().isEmbedded());
+  // the subsets read back their own candidates
+  pat::TauPFCandidateView charged = tau.signalPFChargedHadrCandsView();
+  CPPUNIT_ASSERT(charged.isEmbedded() && sameCands(charged, tau_.signalPFChargedHadrCands()));
+  CPPUNIT_ASSERT(charged[0] != &cands_[0]);
+  CPPUNIT_ASSERT(sameCands(tau.signalPFGammaCandsView(), tau_.signalPFGammaCands()));
+  CPPUNIT_ASSERT(tau.signalPFChargedHadrCands().size() == 2);
+  CPPUNIT_ASSERT(tau.signalPFChargedHadrCands()[1]->pt() == cands_[1].pt());
+  // the subsets not embedded refer to the original candidates
+  CPPUNIT_ASSERT(!tau.signalPFNeutrHadrCandsView().isEmbedded());
+  CPPUNIT_ASSERT(tau.signalPFNeutrHadrCands()[0].get() == &cands_[3]);
+
+  // embedding the full vector afterwards turns the subsets into indices into it
+  tau.embedSignalPFCands();
+  pat::TauPFCandidateView all = tau.signalPFCandsView();
+  CPPUNIT_ASSERT(all.isEmbedded() && all.size() == 4);
+  CPPUNIT_ASSERT(tau.signalPFCands()[0].get() == all[0]);
+  charged = tau.signalPFChargedHadrCandsView();
+  CPPUNIT_ASSERT(sameCands(charged, tau_.signalPFChargedHadrCands()));
+  CPPUNIT_ASSERT(charged[0] == all[0] && charged[1] == all[1]);
+  CPPUNIT_ASSERT(tau.signalPFGammaCandsView()[0] == all[2]);
+  // and the Refs read before are rebuilt
+  CPPUNIT_ASSERT(tau.signalPFChargedHadrCands().size() == 2);
+  CPPUNIT_ASSERT(tau.signalPFChargedHadrCands()[1].get() == all[1]);
+  CPPUNIT_ASSERT(tau.signalPFGammaCands()[0].get() == all[2]);
+}
+
+void testTauPFCandSubsets::testSubsetsAfterAll() {
+  pat::Tau tau(tau_);
+  tau.embedIsolationPFCands();
+  tau.embedIsolationPFChargedHadrCands();
+  tau.embedIsolationPFGammaCands();
+  tau.embedIsolationPFNeutralHadrCands();
+
+  pat::TauPFCandidateView all = tau.isolationPFCandsView();
+  CPPUNIT_ASSERT(all.isEmbedded() && sameCands(all, tau_.isolationPFCands()));
+  CPPUNIT_ASSERT(tau.isolationPFChargedHadrCandsView()[0] == all[0]);
+  CPPUNIT_ASSERT(tau.isolationPFGammaCandsView()[0] == all[1]);
+  CPPUNIT_ASSERT(tau.isolationPFNeutrHadrCandsView().empty());
+  CPPUNIT_ASSERT(tau.isolationPFGammaCands().size() == 1);
+  CPPUNIT_ASSERT(tau.isolationPFGammaCands()[0].get() == all[1]);
+  // the candidates are stored once
+  CPPUNIT_ASSERT(tau.isolationPFCands().size() == 2);
+}
+
+void testTauPFCandSubsets::testSubsetNotInAll() {
+  // a subset candidate which is not in the full vector: the subset is embedded as copies
+  const unsigned int charged[] = { 0, 6 };
+  tau_.setsignalPFChargedHadrCands(makeRefs(cands_, charged, 2));
+  pat::Tau tau(tau_);
+  tau.embedSignalPFCands();
+  tau.embedSignalPFChargedHadrCands();
+  pat::TauPFCandidateView view = tau.signalPFChargedHadrCandsView();
+  CPPUNIT_ASSERT(view.isEmbedded() && sameCands(view, tau_.signalPFChargedHadrCands()));
+  CPPUNIT_ASSERT(view[1]->pt() == cands_[6].pt());
+  CPPUNIT_ASSERT(tau.signalPFCandsView().size() == 4);
+}
+
+void testTauPFCandSubsets::testCopy() {
+  // the indices stay valid in a copy of the tau, as in a tau read from a file
+  pat::Tau original(tau_);
+  original.embedSignalPFChargedHadrCands();
+  original.embedSignalPFCands();
+  pat::Tau tau(original);
+  pat::TauPFCandidateView all = tau.signalPFCandsView();
+  pat::TauPFCandidateView charged = tau.signalPFChargedHadrCandsView();
+  CPPUNIT_ASSERT(charged[1] == all[1] && charged[1] != original.signalPFCandsView()[1]);
+  CPPUNIT_ASSERT(tau.signalPFChargedHadrCands()[0].get() == all[0]);
+}